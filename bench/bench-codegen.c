@@ -0,0 +1,117 @@
+
+/*
+
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2016-2018 Rafa Garcia <rafagarcia77@gmail.com>.
+
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+/*
+ * Benchmark of reading the fields of small messages with the generic parser
+ * and json_getProperty(), and with a parser generated by json-codegen from
+ * the schema order.json.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../tiny-json.h"
+#include "order-parser.h"
+
+enum { MESSAGES = 20000, LOOPS = 50, SIZE = 320, NODES = 32 };
+
+static double seconds( clock_t start ) {
+    return (double)( clock() - start ) / CLOCKS_PER_SEC;
+}
+
+struct pool {
+    jsonPool_t pool;
+    json_t mem[ NODES ];
+    size_t next;
+};
+
+static json_t* poolAlloc( jsonPool_t* pool ) {
+    struct pool* const p = json_containerOf( pool, struct pool, pool );
+    return p->next < NODES? &p->mem[ p->next++ ]: NULL;
+}
+
+static json_t* poolInit( jsonPool_t* pool ) {
+    json_containerOf( pool, struct pool, pool )->next = 0;
+    return poolAlloc( pool );
+}
+
+/** Read the fields of a message with the generic parser. */
+static bool generic( char* str, order_t* out, jsonPool_t* pool ) {
+    json_t const* json = json_createWithPool( str, pool );
+    if ( !json ) return false;
+    json_t const* instrument = json_getProperty( json, "instrument" );
+    if ( !instrument ) return false;
+    out->id = json_getInteger( json_getProperty( json, "id" ) );
+    out->account = json_getPropertyValue( json, "account" );
+    out->symbol = json_getPropertyValue( json, "symbol" );
+    out->side = json_getPropertyValue( json, "side" );
+    out->price = json_getReal( json_getProperty( json, "price" ) );
+    out->qty = json_getInteger( json_getProperty( json, "qty" ) );
+    out->active = json_getBoolean( json_getProperty( json, "active" ) );
+    out->instrument.isin = json_getPropertyValue( instrument, "isin" );
+    out->instrument.lot = json_getInteger( json_getProperty( instrument, "lot" ) );
+    out->instrument.tick = json_getReal( json_getProperty( instrument, "tick" ) );
+    return true;
+}
+
+int main( void ) {
+    static char doc[ MESSAGES ][ SIZE ];
+    static char str[ MESSAGES ][ SIZE ];
+    for( int i = 0; i < MESSAGES; ++i )
+        snprintf( doc[i], SIZE, "{ \"id\": %d, \"account\": \"ACC-%05d\", \"symbol\": \"ABCD\", \"side\": \"%s\","
+                                " \"price\": %d.%02d, \"qty\": %d, \"active\": %s, \"source\": { \"gateway\": \"gw-%d\" },"
+                                " \"instrument\": { \"isin\": \"US0378331005\", \"lot\": 100, \"tick\": 0.01 } }",
+                  i, i % 1000, i % 2? "buy": "sell", 100 + i % 50, i % 100, 1 + i % 500, i % 3? "true": "false", i % 4 );
+
+    static struct pool pool = { { poolInit, poolAlloc } };
+    double sums[2] = { 0, 0 };
+    double times[2] = { 0, 0 };
+    for( int loop = 0; loop < LOOPS; ++loop ) {
+        for( int way = 0; way < 2; ++way ) {
+            memcpy( str, doc, sizeof str );
+            clock_t const start = clock();
+            for( int i = 0; i < MESSAGES; ++i ) {
+                order_t order;
+                bool const ok = way? order_parse( str[i], &order, &pool.pool ): generic( str[i], &order, &pool.pool );
+                if ( !ok ) return EXIT_FAILURE;
+                sums[ way ] += (double)order.id + order.price + (double)order.qty + order.active + order.instrument.tick
+                             + (double)order.instrument.lot + order.account[4] + order.side[0] + order.instrument.isin[11];
+            }
+            times[ way ] += seconds( start );
+        }
+    }
+    if ( sums[0] != sums[1] ) return EXIT_FAILURE;
+
+    double const qty = (double)MESSAGES * LOOPS;
+    printf( "Messages of 10 fields and 1 unknown read into a structure:\n" );
+    printf( "json_create and json_getProperty: %6.1f ns per message\n", times[0] * 1e9 / qty );
+    printf( "Generated order_parse:            %6.1f ns per message\n", times[1] * 1e9 / qty );
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,112 @@
+
+/*
+
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2016-2018 Rafa Garcia <rafagarcia77@gmail.com>.
+
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+/*
+ * Benchmark of the C++ layer against hand-written C that reads the same
+ * five fields of an object with 30 properties.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include "../tiny-json.hpp"
+
+using namespace tinyjson::literals;
+
+constexpr int FIELDS = 30;
+constexpr int LOOPS = 2000000;
+
+static std::string makeDocument() {
+    std::string str = "{";
+    for( int i = 0; i < FIELDS; ++i ) {
+        if ( i ) str += ',';
+        str += "\"field_" + std::to_string( i ) + "\":" + std::to_string( i );
+    }
+    str += ",\"timestamp\":1700000000}";
+    return str;
+}
+
+template<class F>
+static void measure( char const* name, F func ) {
+    auto const start = std::chrono::steady_clock::now();
+    long long sum = 0;
+    for( int i = 0; i < LOOPS; ++i ) sum += func();
+    auto const stop = std::chrono::steady_clock::now();
+    double const ns = std::chrono::duration<double, std::nano>( stop - start ).count() / LOOPS;
+    std::printf( "%-22s %8.1f ns/lookup-set  (checksum %lld)\n", name, ns, sum );
+}
+
+int main() {
+    std::string str = makeDocument();
+    tinyjson::names<64> names;
+    for( int i = 0; i < FIELDS; ++i )
+        names.intern( ( "field_" + std::to_string( i ) ).c_str() );
+    names.intern( "timestamp" );
+    tinyjson::document<64> doc;
+    tinyjson::value const root = doc.parse( str.data(), names );
+    if ( !root ) {
+        std::puts( "Error json create." );
+        return EXIT_FAILURE;
+    }
+    json_t const* const json = root.get();
+
+    measure( "C json_getProperty", [json]() {
+        long long sum = 0;
+        sum += json_getInteger( json_getProperty( json, "field_3" ) );
+        sum += json_getInteger( json_getProperty( json, "field_12" ) );
+        sum += json_getInteger( json_getProperty( json, "field_20" ) );
+        sum += json_getInteger( json_getProperty( json, "field_29" ) );
+        sum += json_getInteger( json_getProperty( json, "timestamp" ) );
+        return sum;
+    } );
+
+    measure( "C++ key literal", [root]() {
+        long long sum = 0;
+        sum += root["field_3"_k].get_or<long long>( 0 );
+        sum += root["field_12"_k].get_or<long long>( 0 );
+        sum += root["field_20"_k].get_or<long long>( 0 );
+        sum += root["field_29"_k].get_or<long long>( 0 );
+        sum += root["timestamp"_k].get_or<long long>( 0 );
+        return sum;
+    } );
+
+    tinyjson::ikey const keys[] = {
+        names["field_3"_k], names["field_12"_k], names["field_20"_k],
+        names["field_29"_k], names["timestamp"_k]
+    };
+    measure( "C++ interned key", [root, &keys]() {
+        long long sum = 0;
+        for( tinyjson::ikey k: keys )
+            sum += root[k].get_or<long long>( 0 );
+        return sum;
+    } );
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,83 @@
+
+/*
+
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2016-2018 Rafa Garcia <rafagarcia77@gmail.com>.
+
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+/*
+ * Benchmark of reading every property of wide objects in the order of the
+ * document with json_getProperty() and with a lookup cursor.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../tiny-json.h"
+
+enum { FIELDS = 64, LOOPS = 20000 };
+
+static double seconds( clock_t start ) {
+    return (double)( clock() - start ) / CLOCKS_PER_SEC;
+}
+
+int main( void ) {
+    static char names[ FIELDS ][ 16 ];
+    static char str[ FIELDS * 32 ];
+    static json_t mem[ FIELDS + 1 ];
+    char* ptr = str;
+    *ptr++ = '{';
+    for( int i = 0; i < FIELDS; ++i ) {
+        sprintf( names[i], "field_%02d", i );
+        ptr += sprintf( ptr, "%s\"%s\":%d", i? ",": "", names[i], i );
+    }
+    strcpy( ptr, "}" );
+    json_t const* obj = json_create( str, mem, FIELDS + 1 );
+    if ( !obj ) return EXIT_FAILURE;
+
+    long sum = 0;
+    clock_t start = clock();
+    for( int loop = 0; loop < LOOPS; ++loop )
+        for( int i = 0; i < FIELDS; ++i )
+            sum += json_getValue( json_getProperty( obj, names[i] ) )[0];
+    double const plain = seconds( start );
+
+    start = clock();
+    for( int loop = 0; loop < LOOPS; ++loop ) {
+        jsonCursor_t cursor;
+        json_initCursor( &cursor, obj );
+        for( int i = 0; i < FIELDS; ++i )
+            sum -= json_getValue( json_getCursorProperty( &cursor, names[i] ) )[0];
+    }
+    double const cursor = seconds( start );
+    if ( sum ) return EXIT_FAILURE;
+
+    double const lookups = (double)LOOPS * FIELDS;
+    printf( "%d properties read in order:\n", FIELDS );
+    printf( "json_getProperty:       %6.1f ns per property\n", plain * 1e9 / lookups );
+    printf( "json_getCursorProperty: %6.1f ns per property\n", cursor * 1e9 / lookups );
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,182 @@
+
+/*
+
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2016-2018 Rafa Garcia <rafagarcia77@gmail.com>.
+
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+/*
+ * Benchmark of the decoding of texts with hexadecimal identifiers, base64
+ * blobs and RFC 3339 timestamps, with scalar helpers after json_getValue()
+ * and with json_decodeHex(), json_decodeBase64() and json_getTimestamp().
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../tiny-json.h"
+
+enum { RECORDS = 20000, LOOPS = 50, NODES = RECORDS * 4 + 1 };
+
+static char* makeDocument( void ) {
+    static char const alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    char* str = malloc( RECORDS * 256 + 16 );
+    if ( !str ) return NULL;
+    char* ptr = str;
+    *ptr++ = '[';
+    for( int i = 0; i < RECORDS; ++i ) {
+        if ( i ) *ptr++ = ',';
+        ptr += sprintf( ptr, "{\"id\":\"%08x%08xdeadbeef%08x\",\"blob\":\"", i * 2654435761u, i, ~i );
+        for( int j = 0; j < 64; ++j )
+            *ptr++ = alphabet[ ( i * 7 + j * 13 ) % 64 ];
+        ptr += sprintf( ptr, "\",\"time\":\"2024-%02d-%02dT%02d:%02d:%02d.%03dZ\"}",
+                        1 + i % 12, 1 + i % 28, i % 24, i % 60, i / 60 % 60, i % 1000 );
+    }
+    strcpy( ptr, "]" );
+    return str;
+}
+
+static double seconds( clock_t start ) {
+    return (double)( clock() - start ) / CLOCKS_PER_SEC;
+}
+
+struct pool {
+    jsonPool_t pool;
+    json_t* mem;
+    size_t next;
+};
+
+static json_t* poolAlloc( jsonPool_t* pool ) {
+    struct pool* const p = json_containerOf( pool, struct pool, pool );
+    return p->next < NODES? &p->mem[ p->next++ ]: NULL;
+}
+
+static json_t* poolInit( jsonPool_t* pool ) {
+    json_containerOf( pool, struct pool, pool )->next = 0;
+    return poolAlloc( pool );
+}
+
+/* Scalar helpers like the ones used after json_getValue(). */
+
+static size_t hexToBytes( char const* str, unsigned char* dst ) {
+    size_t const len = strlen( str );
+    for( size_t i = 0; i + 1 < len; i += 2 ) {
+        unsigned int byte;
+        if ( sscanf( str + i, "%2x", &byte ) != 1 ) return 0;
+        dst[ i / 2 ] = (unsigned char)byte;
+    }
+    return len / 2;
+}
+
+static size_t base64ToBytes( char const* str, unsigned char* dst ) {
+    static char const alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    size_t const len = strlen( str );
+    size_t out = 0;
+    unsigned int bits = 0, qty = 0;
+    for( size_t i = 0; i < len && str[i] != '='; ++i ) {
+        char const* const pos = strchr( alphabet, str[i] );
+        if ( !pos ) return 0;
+        bits = bits << 6 | (unsigned int)( pos - alphabet );
+        qty += 6;
+        if ( qty >= 8 ) {
+            qty -= 8;
+            dst[ out++ ] = (unsigned char)( bits >> qty );
+        }
+    }
+    return out;
+}
+
+static int64_t timestampToNs( char const* str ) {
+    struct tm tm = { 0 };
+    int millis = 0;
+    if ( sscanf( str, "%d-%d-%dT%d:%d:%d.%dZ", &tm.tm_year, &tm.tm_mon, &tm.tm_mday,
+                 &tm.tm_hour, &tm.tm_min, &tm.tm_sec, &millis ) != 7 ) return 0;
+    tm.tm_year -= 1900;
+    tm.tm_mon -= 1;
+    return (int64_t)timegm( &tm ) * 1000000000 + (int64_t)millis * 1000000;
+}
+
+static int64_t checksum;
+
+static void decodeScalar( json_t const* json ) {
+    unsigned char bytes[64];
+    for( json_t const* i = json_getChild( json ); i; i = json_getSibling( i ) ) {
+        checksum += hexToBytes( json_getPropertyValue( i, "id" ), bytes ) + bytes[0];
+        checksum += base64ToBytes( json_getPropertyValue( i, "blob" ), bytes ) + bytes[0];
+        checksum += timestampToNs( json_getPropertyValue( i, "time" ) );
+    }
+}
+
+static void decodeFast( json_t const* json ) {
+    size_t size;
+    int64_t ns;
+    for( json_t const* i = json_getChild( json ); i; i = json_getSibling( i ) ) {
+        unsigned char const* bytes = json_decodeHex( json_getProperty( i, "id" ), &size );
+        checksum += size + bytes[0];
+        bytes = json_decodeBase64( json_getProperty( i, "blob" ), &size );
+        checksum += size + bytes[0];
+        if ( json_getTimestamp( json_getProperty( i, "time" ), &ns ) ) checksum += ns;
+    }
+}
+
+static double run( char const* doc, char* str, size_t len, struct pool* pool, void (*decode)( json_t const* ),
+                   double* parsing ) {
+    double total = 0;
+    *parsing = 0;
+    for( int i = 0; i < LOOPS; ++i ) {
+        memcpy( str, doc, len + 1 );
+        clock_t start = clock();
+        json_t const* json = json_createWithPool( str, &pool->pool );
+        *parsing += seconds( start );
+        if ( !json ) exit( EXIT_FAILURE );
+        start = clock();
+        decode( json );
+        total += seconds( start );
+    }
+    *parsing *= 1e9 / RECORDS / LOOPS;
+    return total * 1e9 / RECORDS / LOOPS;
+}
+
+int main( void ) {
+    char* const doc = makeDocument();
+    char* const str = malloc( RECORDS * 256 + 16 );
+    struct pool pool = { { poolInit, poolAlloc }, malloc( NODES * sizeof( json_t ) ), 0 };
+    if ( !doc || !str || !pool.mem ) return EXIT_FAILURE;
+    size_t const len = strlen( doc );
+    double parsing;
+    double const scalar = run( doc, str, len, &pool, decodeScalar, &parsing );
+    int64_t const expected = checksum;
+    checksum = 0;
+    double const fast = run( doc, str, len, &pool, decodeFast, &parsing );
+    if ( checksum != expected ) return EXIT_FAILURE;
+    printf( "Records with a hex id, a base64 blob of 64 characters and a timestamp:\n" );
+    printf( "parse:                              %7.1f ns per record\n", parsing );
+    printf( "scalar helpers:                     %7.1f ns per record\n", scalar );
+    printf( "json_decode* and json_getTimestamp: %7.1f ns per record\n", fast );
+    free( pool.mem );
+    free( str );
+    free( doc );
+    return EXIT_SUCCESS;
+}
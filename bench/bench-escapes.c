@@ -0,0 +1,107 @@
+
+/*
+
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2016-2018 Rafa Garcia <rafagarcia77@gmail.com>.
+
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+/*
+ * Benchmark of the parse of a document with long escaped texts, like HTML or
+ * JSON inside JSON, decoding them while parsing and with JSON_DEFER_ESCAPES.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../tiny-json.h"
+
+enum { RECORDS = 20000, LOOPS = 50, NODES = RECORDS * 4 + 1 };
+
+static char* makeDocument( void ) {
+    char* str = malloc( RECORDS * 768 + 16 );
+    if ( !str ) return NULL;
+    char* ptr = str;
+    *ptr++ = '[';
+    for( int i = 0; i < RECORDS; ++i ) {
+        if ( i ) *ptr++ = ',';
+        ptr += sprintf( ptr, "{\"id\":%d,\"html\":\"<div class=\\\"item\\\" id=\\\"i%d\\\">"
+                             "<a href=\\\"\\/items\\/%d\\\">Item number %d<\\/a>\\n<p>The item is delivered in two days to any"
+                             " address of the country, and it can be returned for free in the first month after"
+                             " the purchase if it has not been used.<\\/p>\\n<\\/div>\\n\","
+                             "\"payload\":\"{\\\"id\\\":%d,\\\"tags\\\":[\\\"a\\\",\\\"b\\\"],"
+                             "\\\"note\\\":\\\"forwarded as it is\\\"}\"}", i, i, i, i, i );
+    }
+    strcpy( ptr, "]" );
+    return str;
+}
+
+static double seconds( clock_t start ) {
+    return (double)( clock() - start ) / CLOCKS_PER_SEC;
+}
+
+struct pool {
+    jsonPool_t pool;
+    json_t* mem;
+    size_t next;
+};
+
+static json_t* poolAlloc( jsonPool_t* pool ) {
+    struct pool* const p = json_containerOf( pool, struct pool, pool );
+    return p->next < NODES? &p->mem[ p->next++ ]: NULL;
+}
+
+static json_t* poolInit( jsonPool_t* pool ) {
+    json_containerOf( pool, struct pool, pool )->next = 0;
+    return poolAlloc( pool );
+}
+
+static double parse( char const* doc, char* str, size_t len, struct pool* pool, unsigned int options ) {
+    double total = 0;
+    for( int i = 0; i < LOOPS; ++i ) {
+        memcpy( str, doc, len + 1 );
+        clock_t const start = clock();
+        json_t const* json = json_createWithOptions( str, &pool->pool, NULL, options );
+        total += seconds( start );
+        if ( !json ) exit( EXIT_FAILURE );
+    }
+    return (double)len * LOOPS / 1e6 / total;
+}
+
+int main( void ) {
+    char* const doc = makeDocument();
+    char* const str = malloc( RECORDS * 768 + 16 );
+    struct pool pool = { { poolInit, poolAlloc }, malloc( NODES * sizeof( json_t ) ), 0 };
+    if ( !doc || !str || !pool.mem ) return EXIT_FAILURE;
+    size_t const len = strlen( doc );
+    double const eager = parse( doc, str, len, &pool, 0 );
+    double const deferred = parse( doc, str, len, &pool, JSON_DEFER_ESCAPES );
+    printf( "decoded while parsing: %7.1f MB/s\n", eager );
+    printf( "JSON_DEFER_ESCAPES:    %7.1f MB/s\n", deferred );
+    free( pool.mem );
+    free( str );
+    free( doc );
+    return EXIT_SUCCESS;
+}
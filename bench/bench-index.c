@@ -0,0 +1,104 @@
+
+/*
+
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2016-2018 Rafa Garcia <rafagarcia77@gmail.com>.
+
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+/*
+ * Benchmark of joining the rows of a catalog by their "id" with a walk
+ * over the array and with a keyed index built by json_indexArrayBy().
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../tiny-json.h"
+
+enum { ROWS = 100000, SCANS = 2000, LOOPS = 500 };
+
+static double seconds( clock_t start ) {
+    return (double)( clock() - start ) / CLOCKS_PER_SEC;
+}
+
+/** Pool with consecutive json properties for the catalog and its index. */
+static json_t mem[ 8 * ROWS ];
+static size_t next;
+
+static json_t* alloc( jsonPool_t* pool ) {
+    (void)pool;
+    return next < sizeof mem / sizeof *mem? &mem[ next++ ]: NULL;
+}
+
+static json_t* init( jsonPool_t* pool ) {
+    next = 0;
+    return alloc( pool );
+}
+
+/** Search a row by a walk over the array. */
+static json_t const* scan( json_t const* array, int64_t id ) {
+    for( json_t const* row = json_getChild( array ); row; row = json_getSibling( row ) )
+        if ( json_getInteger( json_getProperty( row, "id" ) ) == id )
+            return row;
+    return NULL;
+}
+
+int main( void ) {
+    static char str[ ROWS * 48 ];
+    char* ptr = str;
+    *ptr++ = '[';
+    for( int i = 0; i < ROWS; ++i )
+        ptr += sprintf( ptr, "%s{\"id\":%d,\"name\":\"item\",\"price\":%d}", i? ",": "", 7 * i + 1, i % 100 );
+    strcpy( ptr, "]" );
+    jsonPool_t pool = { init, alloc };
+    json_t const* array = json_createWithPool( str, &pool );
+    if ( !array ) return EXIT_FAILURE;
+
+    long sum = 0;
+    clock_t start = clock();
+    for( int i = 0; i < SCANS; ++i )
+        sum += json_getInteger( json_getProperty( scan( array, 7 * ( i * 37 % ROWS ) + 1 ), "price" ) );
+    sum *= LOOPS;
+    double const walk = seconds( start );
+
+    start = clock();
+    jsonIndex_t index;
+    if ( !json_indexArrayBy( &index, array, "id", &pool ) ) return EXIT_FAILURE;
+    double const build = seconds( start );
+
+    start = clock();
+    for( int loop = 0; loop < LOOPS; ++loop )
+        for( int i = 0; i < SCANS; ++i )
+            sum -= json_getInteger( json_getProperty( json_getIndexedInteger( &index, 7 * ( i * 37 % ROWS ) + 1 ), "price" ) );
+    double const indexed = seconds( start );
+    if ( sum ) return EXIT_FAILURE;
+
+    printf( "Join by id with a catalog of %d rows:\n", ROWS );
+    printf( "Walk over the array: %10.1f ns per row\n", walk * 1e9 / SCANS );
+    printf( "json_indexArrayBy:   %10.1f ns per row of the catalog\n", build * 1e9 / ROWS );
+    printf( "json_getIndexed:     %10.1f ns per row\n", indexed * 1e9 / ( (double)LOOPS * SCANS ) );
+    return EXIT_SUCCESS;
+}
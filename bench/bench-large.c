@@ -0,0 +1,104 @@
+
+/*
+
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2016-2018 Rafa Garcia <rafagarcia77@gmail.com>.
+
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+/*
+ * Parse of a synthetic document bigger than 4 GB: one text of several
+ * gigabytes followed by an array of small rows. The document is written to
+ * a temporary file and mapped privately, so only the pages where the parser
+ * writes null characters take memory besides the json properties.
+ * Usage: bench-large.exe [gigabytes of the text] [number of rows]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/mman.h>
+#include "../tiny-json.h"
+
+static double seconds( clock_t start ) {
+    return (double)( clock() - start ) / CLOCKS_PER_SEC;
+}
+
+/** Write the document and get its length without the final null character. */
+static size_t generate( FILE* file, size_t textsize, size_t rows ) {
+    static char chunk[ 1 << 20 ];
+    memset( chunk, 'x', sizeof chunk );
+    size_t len = (size_t)fprintf( file, "{\"text\":\"" );
+    size_t left;
+    for( left = textsize; left; ) {
+        size_t const n = left < sizeof chunk? left: sizeof chunk;
+        len += fwrite( chunk, 1, n, file );
+        left -= n;
+    }
+    len += (size_t)fprintf( file, "\",\"rows\":[" );
+    size_t i;
+    for( i = 0; i < rows; ++i )
+        len += (size_t)fprintf( file, "%s{\"id\":%zu,\"ok\":true}", i? ",": "", i );
+    len += (size_t)fprintf( file, "]}" );
+    fputc( '\0', file );
+    return len;
+}
+
+int main( int argc, char** argv ) {
+    double const gigabytes = argc > 1? atof( argv[1] ): 4.5;
+    size_t const rows = argc > 2? (size_t)atoll( argv[2] ): 10000000;
+    size_t const textsize = (size_t)( gigabytes * 1024 * 1024 * 1024 );
+    size_t const qty = 4 + 3 * rows;
+
+    FILE* const file = tmpfile();
+    if ( !file ) return EXIT_FAILURE;
+    clock_t start = clock();
+    size_t const len = generate( file, textsize, rows );
+    if ( fflush( file ) ) return EXIT_FAILURE;
+    printf( "Generated %.2f GB in %.1f s\n", len / 1e9, seconds( start ) );
+
+    char* const str = mmap( NULL, len + 1, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileno( file ), 0 );
+    json_t* const mem = malloc( qty * sizeof *mem );
+    if ( str == MAP_FAILED || !mem ) return EXIT_FAILURE;
+
+    start = clock();
+    json_t const* const json = json_create( str, mem, qty );
+    double const elapsed = seconds( start );
+    if ( !json ) return EXIT_FAILURE;
+
+    json_t const* const text = json_getProperty( json, "text" );
+    json_t const* row = json_getChild( json_getProperty( json, "rows" ) );
+    size_t count = 0;
+    for( ; row; row = json_getSibling( row ), ++count )
+        if ( (size_t)json_getInteger( json_getProperty( row, "id" ) ) != count ) return EXIT_FAILURE;
+    if ( !text || strlen( json_getValue( text ) ) != textsize || count != rows ) return EXIT_FAILURE;
+
+    printf( "Parsed in %.1f s, %.2f GB/s\n", elapsed, len / 1e9 / elapsed );
+    printf( "%zu json properties of %zu bytes: %.2f GB\n", qty, sizeof *mem, qty * sizeof *mem / 1e9 );
+
+    munmap( str, len + 1 );
+    free( mem );
+    fclose( file );
+    return EXIT_SUCCESS;
+}
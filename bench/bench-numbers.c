@@ -0,0 +1,130 @@
+
+/*
+
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2016-2018 Rafa Garcia <rafagarcia77@gmail.com>.
+
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+/*
+ * Benchmark of the parse and the access of a document made of numbers,
+ * like arrays of timestamps and readings of telemetry.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../tiny-json.h"
+
+enum { QTY = 1000000, LOOPS = 10 };
+
+static char* makeDocument( void ) {
+    char* str = malloc( QTY * 32 + 16 );
+    if ( !str ) return NULL;
+    char* ptr = str;
+    *ptr++ = '[';
+    for( int i = 0; i < QTY; ++i ) {
+        if ( i ) *ptr++ = ',';
+        if ( i % 2 ) ptr += sprintf( ptr, "%lld", 1700000000000LL + i * 37LL );
+        else ptr += sprintf( ptr, "%d.%03d", i % 1000, i % 997 );
+    }
+    strcpy( ptr, "]" );
+    return str;
+}
+
+struct pool {
+    jsonPool_t pool;
+    json_t* mem;
+    size_t qty;
+    size_t next;
+};
+
+static json_t* poolAlloc( jsonPool_t* pool ) {
+    struct pool* p = (struct pool*)pool;
+    return p->next < p->qty? p->mem + p->next++: NULL;
+}
+
+static json_t* poolInit( jsonPool_t* pool ) {
+    ( (struct pool*)pool )->next = 0;
+    return poolAlloc( pool );
+}
+
+static double seconds( clock_t start ) {
+    return (double)( clock() - start ) / CLOCKS_PER_SEC;
+}
+
+int main( void ) {
+    char* const doc = makeDocument();
+    char* const str = malloc( QTY * 32 + 16 );
+    json_t* const mem = malloc( ( QTY + 1 ) * sizeof *mem );
+    if ( !doc || !str || !mem ) return EXIT_FAILURE;
+    size_t const len = strlen( doc ) + 1;
+
+    double parse = 0;
+    json_t const* json = NULL;
+    for( int i = 0; i < LOOPS; ++i ) {
+        memcpy( str, doc, len );
+        clock_t const start = clock();
+        json = json_create( str, mem, QTY + 1 );
+        parse += seconds( start );
+        if ( !json ) return EXIT_FAILURE;
+    }
+
+    clock_t const start = clock();
+    double sum = 0;
+    for( int i = 0; i < LOOPS; ++i )
+        for( json_t const* n = json_getChild( json ); n; n = json_getSibling( n ) )
+            sum += JSON_INTEGER == json_getType( n )? (double)json_getInteger( n ): json_getReal( n );
+    double const access = seconds( start );
+
+    double const mb = (double)len * LOOPS / 1e6;
+    printf( "parse:         %7.1f MB/s\n", mb / parse );
+    printf( "access:        %7.1f ns/value (checksum %g)\n", access * 1e9 / ( (double)QTY * LOOPS ), sum );
+
+    struct pool pool = { { poolInit, poolAlloc }, mem, QTY + 1, 0 };
+    parse = 0;
+    for( int i = 0; i < LOOPS; ++i ) {
+        memcpy( str, doc, len );
+        clock_t const start = clock();
+        json = json_createWithOptions( str, &pool.pool, NULL, JSON_PACK_NUMBERS );
+        parse += seconds( start );
+        if ( !json ) return EXIT_FAILURE;
+    }
+    clock_t const startPacked = clock();
+    sum = 0;
+    for( int i = 0; i < LOOPS; ++i ) {
+        double const* values = json_getArrayData( json );
+        size_t const qty = json_getArrayLength( json );
+        for( size_t j = 0; j < qty; ++j )
+            sum += values[j];
+    }
+    double const packed = seconds( startPacked );
+    printf( "packed parse:  %7.1f MB/s, %zu json_t\n", mb / parse, pool.next );
+    printf( "packed access: %7.1f ns/value (checksum %g)\n", packed * 1e9 / ( (double)QTY * LOOPS ), sum );
+    free( mem );
+    free( str );
+    free( doc );
+    return EXIT_SUCCESS;
+}
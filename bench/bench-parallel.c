@@ -0,0 +1,170 @@
+
+/*
+
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2016-2018 Rafa Garcia <rafagarcia77@gmail.com>.
+
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+/*
+ * Benchmark of the parse of one big top-level array of records in one thread
+ * with json_createWithPool() and in parts with json_splitArray() and several
+ * threads, each one with its own pool.
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../tiny-json.h"
+
+enum { RECORDS = 400000, NODES = RECORDS * 12 + 1, LOOPS = 5, MAXTHREADS = 8 };
+
+static char* makeDocument( void ) {
+    char* str = malloc( (size_t)RECORDS * 192 + 16 );
+    if ( !str ) return NULL;
+    char* ptr = str;
+    *ptr++ = '[';
+    for( int i = 0; i < RECORDS; ++i ) {
+        if ( i ) *ptr++ = ',';
+        ptr += sprintf( ptr, "{\"id\":%d,\"name\":\"customer \\\"%d\\\"\",\"tags\":[\"a\",\"b,c\"],"
+                             "\"balance\":%d.%02d,\"active\":%s,\"address\":{\"city\":\"Town %d\",\"zip\":\"%05d\"}}",
+                        i, i, i % 9999, i % 100, i % 3? "true": "false", i % 500, i % 100000 );
+    }
+    strcpy( ptr, "]" );
+    return str;
+}
+
+/** Pool of consecutive json properties of one thread. */
+struct pool {
+    jsonPool_t pool;
+    json_t* mem;
+    size_t next;
+};
+
+static json_t* poolAlloc( jsonPool_t* pool ) {
+    struct pool* const p = json_containerOf( pool, struct pool, pool );
+    return p->next < NODES? &p->mem[ p->next++ ]: NULL;
+}
+
+static json_t* poolInit( jsonPool_t* pool ) {
+    json_containerOf( pool, struct pool, pool )->next = 0;
+    return poolAlloc( pool );
+}
+
+static jsonSplit_t split;
+static struct pool pools[ MAXTHREADS ];
+
+struct task {
+    unsigned int part;
+    bool parse;
+    bool ok;
+};
+
+static void* worker( void* arg ) {
+    struct task* const task = arg;
+    if ( task->parse ) task->ok = json_parsePart( &split, task->part, &pools[ task->part ].pool );
+    else json_scanPart( &split, task->part );
+    return NULL;
+}
+
+/** Run a step of the parse in parallel, one part per thread. */
+static bool runParts( unsigned int qty, bool parse ) {
+    pthread_t ids[ MAXTHREADS ];
+    struct task tasks[ MAXTHREADS ];
+    for( unsigned int i = 0; i < qty; ++i ) {
+        tasks[i].part = i;
+        tasks[i].parse = parse;
+        tasks[i].ok = true;
+        if ( pthread_create( &ids[i], NULL, worker, &tasks[i] ) ) abort();
+    }
+    bool ok = true;
+    for( unsigned int i = 0; i < qty; ++i ) {
+        pthread_join( ids[i], NULL );
+        ok = ok && tasks[i].ok;
+    }
+    return ok;
+}
+
+static json_t const* parseParallel( char* str, size_t len, unsigned int threads ) {
+    unsigned int const qty = json_splitArray( &split, str, len, threads, 0 );
+    if ( !qty ) return NULL;
+    runParts( qty, false );
+    if ( !json_findElements( &split ) ) return NULL;
+    if ( !runParts( qty, true ) ) return NULL;
+    return json_joinParts( &split );
+}
+
+static double now( void ) {
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static size_t count( json_t const* json ) {
+    size_t qty = 0;
+    for( json_t const* i = json_getChild( json ); i; i = json_getSibling( i ) ) ++qty;
+    return qty;
+}
+
+int main( void ) {
+    char* const doc = makeDocument();
+    char* const str = malloc( (size_t)RECORDS * 192 + 16 );
+    if ( !doc || !str ) return EXIT_FAILURE;
+    for( int i = 0; i < MAXTHREADS; ++i ) {
+        pools[i].pool.init = poolInit;
+        pools[i].pool.alloc = poolAlloc;
+        pools[i].mem = malloc( NODES * sizeof( json_t ) );
+        if ( !pools[i].mem ) return EXIT_FAILURE;
+    }
+    size_t const len = strlen( doc );
+    printf( "Array of %d records, %.1f MB\n", RECORDS, len / 1e6 );
+    double best = 1e9;
+    for( int loop = 0; loop < LOOPS; ++loop ) {
+        memcpy( str, doc, len + 1 );
+        double const start = now();
+        json_t const* const json = json_createWithPool( str, &pools[0].pool );
+        double const elapsed = now() - start;
+        if ( !json || count( json ) != RECORDS ) return EXIT_FAILURE;
+        if ( elapsed < best ) best = elapsed;
+    }
+    printf( "json_createWithPool:  %7.1f MB/s\n", len / 1e6 / best );
+    for( unsigned int threads = 1; threads <= MAXTHREADS; threads *= 2 ) {
+        best = 1e9;
+        for( int loop = 0; loop < LOOPS; ++loop ) {
+            memcpy( str, doc, len + 1 );
+            double const start = now();
+            json_t const* const json = parseParallel( str, len, threads );
+            double const elapsed = now() - start;
+            if ( !json || count( json ) != RECORDS ) return EXIT_FAILURE;
+            if ( elapsed < best ) best = elapsed;
+        }
+        printf( "%u threads:            %7.1f MB/s\n", threads, len / 1e6 / best );
+    }
+    for( int i = 0; i < MAXTHREADS; ++i )
+        free( pools[i].mem );
+    free( str );
+    free( doc );
+    return EXIT_SUCCESS;
+}
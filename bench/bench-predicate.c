@@ -0,0 +1,128 @@
+
+/*
+
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2016-2018 Rafa Garcia <rafagarcia77@gmail.com>.
+
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+/*
+ * Benchmark of a filter of NDJSON records by their level, about one in twenty
+ * of them, with a parse of every record and with json_matchRecord() before
+ * the parse of the matching ones.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../tiny-json.h"
+
+enum { RECORDS = 200000, LOOPS = 10, NODES = 32 };
+
+static char* makeDocument( void ) {
+    static char const* const levels[] = { "info", "debug", "warn" };
+    char* str = malloc( (size_t)RECORDS * 256 + 16 );
+    if ( !str ) return NULL;
+    char* ptr = str;
+    for( int i = 0; i < RECORDS; ++i ) {
+        char const* const level = i % 20 == 7? "error": levels[ i % 3 ];
+        ptr += sprintf( ptr, "{\"ts\":\"2024-03-01T12:%02d:%02d.%03dZ\",\"level\":\"%s\",\"msg\":\"request %d "
+                             "served in %d ms\",\"meta\":{\"host\":\"web-%d\",\"status\":%d,\"bytes\":%d}}\n",
+                        i / 60 % 60, i % 60, i % 1000, level, i, i % 250, i % 16, i % 7? 200: 500, i * 37 % 65536 );
+    }
+    *ptr = '\0';
+    return str;
+}
+
+static double seconds( clock_t start ) {
+    return (double)( clock() - start ) / CLOCKS_PER_SEC;
+}
+
+static long checksum;
+
+static void use( json_t const* json ) {
+    json_t const* const meta = json_getProperty( json, "meta" );
+    checksum += (long)json_getInteger( json_getProperty( meta, "bytes" ) );
+}
+
+static jsonPredicate_t pred;
+
+static void parseAll( char* str ) {
+    json_t mem[ NODES ];
+    for( char* line = str; *line; ) {
+        char* const end = strchr( line, '\n' );
+        *end = '\0';
+        json_t const* const json = json_create( line, mem, NODES );
+        if ( !json ) exit( EXIT_FAILURE );
+        char const* const level = json_getPropertyValue( json, "level" );
+        if ( level && !strcmp( level, "error" ) ) use( json );
+        line = end + 1;
+    }
+}
+
+static void parseMatching( char* str ) {
+    json_t mem[ NODES ];
+    for( char* line = str; *line; ) {
+        char* const end = strchr( line, '\n' );
+        if ( json_matchRecord( line, (size_t)( end - line ), &pred, 1 ) ) {
+            *end = '\0';
+            json_t const* const json = json_create( line, mem, NODES );
+            if ( !json ) exit( EXIT_FAILURE );
+            use( json );
+        }
+        line = end + 1;
+    }
+}
+
+/* Each loop filters its own copy, the parse writes null characters. */
+static double run( char const* doc, char* str, size_t len, void (*filter)( char* ) ) {
+    double total = 0;
+    for( int i = 0; i < LOOPS; ++i ) {
+        memcpy( str, doc, len + 1 );
+        clock_t const start = clock();
+        filter( str );
+        total += seconds( start );
+    }
+    return total * 1e9 / RECORDS / LOOPS;
+}
+
+int main( void ) {
+    char* const doc = makeDocument();
+    if ( !doc ) return EXIT_FAILURE;
+    size_t const len = strlen( doc );
+    char* const str = malloc( len + 1 );
+    if ( !str ) return EXIT_FAILURE;
+    if ( !json_initTextPredicate( &pred, "level", JSON_EQUAL, "error" ) ) return EXIT_FAILURE;
+    double const full = run( doc, str, len, parseAll );
+    long const expected = checksum;
+    checksum = 0;
+    double const filtered = run( doc, str, len, parseMatching );
+    if ( checksum != expected ) return EXIT_FAILURE;
+    printf( "NDJSON records with level \"error\", one in twenty:\n" );
+    printf( "parse of every record:           %7.1f ns per record\n", full );
+    printf( "json_matchRecord() before parse: %7.1f ns per record\n", filtered );
+    free( str );
+    free( doc );
+    return EXIT_SUCCESS;
+}
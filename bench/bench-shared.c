@@ -0,0 +1,140 @@
+
+/*
+
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2016-2018 Rafa Garcia <rafagarcia77@gmail.com>.
+
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+/*
+ * Benchmark of threads that parse small messages and allocate from one pool
+ * shared by all of them: contexts of a jsonShared_t, that take chunks with
+ * atomic operations, against a pool that takes a mutex on every allocation.
+ * The json properties are given back every BATCH messages.
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../tiny-json.h"
+#include "../tiny-json-shared.h"
+
+enum { MESSAGES = 400000, BATCH = 64, NODES = 1 << 16, CHUNK = 256, MAXTHREADS = 8 };
+
+static char const message[] =
+    "{\"id\":1234,\"type\":\"order\",\"items\":[{\"sku\":\"A-1\",\"qty\":2},{\"sku\":\"B-7\",\"qty\":1}],"
+    "\"total\":35.5,\"paid\":true,\"notes\":null}";
+
+static json_t mem[ NODES ];
+
+static jsonShared_t shared;
+
+static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+static unsigned int freeNodes[ NODES ];
+static unsigned int freeQty;
+
+/** Pool that takes a free json property with a mutex on every allocation. */
+struct lockedPool {
+    jsonPool_t pool;
+    unsigned int qty;
+    unsigned int used[ BATCH * 16 ];
+};
+
+static json_t* lockedAlloc( jsonPool_t* pool ) {
+    struct lockedPool* const lp = json_containerOf( pool, struct lockedPool, pool );
+    if ( lp->qty == sizeof lp->used / sizeof *lp->used ) return NULL;
+    pthread_mutex_lock( &mutex );
+    unsigned int const node = freeQty? freeNodes[ --freeQty ]: NODES;
+    pthread_mutex_unlock( &mutex );
+    if ( node == NODES ) return NULL;
+    lp->used[ lp->qty++ ] = node;
+    return &mem[ node ];
+}
+
+static void lockedRelease( struct lockedPool* lp ) {
+    pthread_mutex_lock( &mutex );
+    while( lp->qty ) freeNodes[ freeQty++ ] = lp->used[ --lp->qty ];
+    pthread_mutex_unlock( &mutex );
+}
+
+static void* lockedWorker( void* arg ) {
+    long const qty = *(long const*)arg;
+    struct lockedPool lp = { { lockedAlloc, lockedAlloc }, 0, { 0 } };
+    char str[ sizeof message ];
+    for( long i = 0; i < qty; ++i ) {
+        memcpy( str, message, sizeof message );
+        if ( !json_createWithPool( str, &lp.pool ) ) abort();
+        if ( i % BATCH == BATCH - 1 ) lockedRelease( &lp );
+    }
+    lockedRelease( &lp );
+    return NULL;
+}
+
+static void* sharedWorker( void* arg ) {
+    long const qty = *(long const*)arg;
+    jsonContext_t ctx;
+    json_initContext( &ctx, &shared );
+    char str[ sizeof message ];
+    for( long i = 0; i < qty; ++i ) {
+        memcpy( str, message, sizeof message );
+        if ( !json_createWithContext( str, &ctx, NULL, 0 ) ) abort();
+        if ( i % BATCH == BATCH - 1 ) json_releaseContext( &ctx );
+    }
+    json_releaseContext( &ctx );
+    return NULL;
+}
+
+static double now( void ) {
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/** Run a worker in several threads that parse MESSAGES messages in total.
+  * @return The number of messages parsed per microsecond. */
+static double run( void* (*worker)( void* ), int threads ) {
+    pthread_t ids[ MAXTHREADS ];
+    long qty = MESSAGES / threads;
+    double const start = now();
+    for( int i = 0; i < threads; ++i )
+        if ( pthread_create( &ids[i], NULL, worker, &qty ) ) abort();
+    for( int i = 0; i < threads; ++i )
+        pthread_join( ids[i], NULL );
+    return (double)qty * threads / ( now() - start ) / 1e6;
+}
+
+int main( void ) {
+    if ( !json_initShared( &shared, mem, NODES, CHUNK ) ) return EXIT_FAILURE;
+    for( freeQty = 0; freeQty < NODES; ++freeQty )
+        freeNodes[ freeQty ] = freeQty;
+    puts( "threads  mutex per allocation  shared chunks  (messages per us)" );
+    for( int threads = 1; threads <= MAXTHREADS; threads *= 2 ) {
+        double const locked = run( lockedWorker, threads );
+        double const chunks = run( sharedWorker, threads );
+        printf( "%7d  %20.2f  %13.2f\n", threads, locked, chunks );
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,93 @@
+
+/*
+
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2016-2018 Rafa Garcia <rafagarcia77@gmail.com>.
+
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+/*
+ * Benchmark of json_validate() against a full parse of the same document
+ * made of records with texts, numbers and nested arrays.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../tiny-json.h"
+
+enum { RECORDS = 100000, LOOPS = 20 };
+
+static char* makeDocument( size_t* nodes ) {
+    char* str = malloc( RECORDS * 256 + 16 );
+    if ( !str ) return NULL;
+    char* ptr = str;
+    *ptr++ = '[';
+    for( int i = 0; i < RECORDS; ++i ) {
+        if ( i ) *ptr++ = ',';
+        ptr += sprintf( ptr, "\n  {\"id\": %d, \"name\": \"Customer number %d\", \"price\": %d.%02d,"
+                             " \"active\": %s, \"tags\": [\"retail\", \"priority-%d\"],"
+                             " \"note\": \"Delivered to the \\\"main\\\" office at 10:%02d\"}",
+                        i, i, i % 500, i % 100, i % 3? "true": "false", i % 5, i % 60 );
+    }
+    strcpy( ptr, "\n]" );
+    *nodes = RECORDS * 9 + 1;
+    return str;
+}
+
+static double seconds( clock_t start ) {
+    return (double)( clock() - start ) / CLOCKS_PER_SEC;
+}
+
+int main( void ) {
+    size_t nodes;
+    char* const doc = makeDocument( &nodes );
+    char* const str = malloc( RECORDS * 256 + 16 );
+    json_t* const mem = malloc( nodes * sizeof *mem );
+    if ( !doc || !str || !mem ) return EXIT_FAILURE;
+    size_t const len = strlen( doc );
+
+    double parse = 0;
+    for( int i = 0; i < LOOPS; ++i ) {
+        memcpy( str, doc, len + 1 );
+        clock_t const start = clock();
+        json_t const* json = json_create( str, mem, (unsigned int)nodes );
+        parse += seconds( start );
+        if ( !json ) return EXIT_FAILURE;
+    }
+
+    clock_t const start = clock();
+    for( int i = 0; i < LOOPS; ++i )
+        if ( !json_validate( doc, len ) ) return EXIT_FAILURE;
+    double const validate = seconds( start );
+
+    double const mb = (double)len * LOOPS / 1e6;
+    printf( "parse:    %7.1f MB/s\n", mb / parse );
+    printf( "validate: %7.1f MB/s (no copy of the input needed)\n", mb / validate );
+    free( mem );
+    free( str );
+    free( doc );
+    return EXIT_SUCCESS;
+}
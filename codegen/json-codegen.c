@@ -0,0 +1,388 @@
+
+/*
+
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2016-2018 Rafa Garcia <rafagarcia77@gmail.com>.
+
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+/*
+ * Generator of parsers specialized for known message shapes.
+ *
+ * Usage: json-codegen schema.json name
+ *
+ * The schema is a JSON object whose properties are message types. Each one is
+ * an object whose properties are the fields of the message, with the values
+ * "integer", "real", "text", "boolean" or a nested object with more fields:
+ *
+ *   { "order": { "id": "integer", "price": "real", "symbol": "text",
+ *                "instrument": { "isin": "text", "lot": "integer" } } }
+ *
+ * It writes name.h and name.c. For each type it declares a structure,
+ * order_t in the example, and a function to fill it from a JSON string,
+ * order_parse(). The names are matched by a switch on their length and
+ * first character. The fields that are not in the schema, or whose values
+ * are of another type, are parsed by the generic parser of tiny-json and
+ * dropped.
+ */
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../tiny-json.h"
+
+enum { MAX_FIELDS = 256, MAX_NODES = 4096 };
+
+/** Type of a field of a message. */
+typedef enum { INTEGER, REAL, TEXT, BOOLEAN, OBJECT } fieldType_t;
+
+/** Get the type of a field of the schema.
+  * @return The type or -1 if it is not valid. */
+static int fieldType( json_t const* field ) {
+    static char const* const names[] = { "integer", "real", "text", "boolean" };
+    if ( json_getType( field ) == JSON_OBJ ) return OBJECT;
+    if ( json_getType( field ) != JSON_TEXT ) return -1;
+    for( int i = 0; i < (int)( sizeof names / sizeof *names ); ++i )
+        if ( !strcmp( names[i], json_getValue( field ) ) )
+            return i;
+    return -1;
+}
+
+/** Write a name as a C identifier. The characters that are not valid are
+  * written as underscores. */
+static void writeIdentifier( FILE* file, char const* name ) {
+    if ( isdigit( (unsigned char)*name ) ) fputc( '_', file );
+    for( ; *name; ++name )
+        fputc( isalnum( (unsigned char)*name )? *name: '_', file );
+}
+
+/** Write a name as a C string literal. */
+static void writeLiteral( FILE* file, char const* name ) {
+    fputc( '\"', file );
+    for( ; *name; ++name ) {
+        unsigned char const ch = (unsigned char)*name;
+        if ( ch == '\"' || ch == '\\' || ch == '?' ) fprintf( file, "\\%c", ch );
+        else if ( isprint( ch ) ) fputc( ch, file );
+        else fprintf( file, "\\%03o", ch );
+    }
+    fputc( '\"', file );
+}
+
+/** Join the path of a field and its name with an underscore.
+  * @return 0 if success or -1 if it is too long. */
+static int joinPath( char dst[ 512 ], char const* path, char const* name ) {
+    int const len = snprintf( dst, 512, "%s_%s", path, name );
+    if ( len >= 0 && len < 512 ) return 0;
+    fprintf( stderr, "The path '%s' is too long.\n", path );
+    return -1;
+}
+
+/** Write spaces to indent a line. */
+static void indent( FILE* file, int level ) {
+    fprintf( file, "%*s", level * 4, "" );
+}
+
+/** Write the members of the structure of a message. Nested objects are nested
+  * structures tagged with their path so that their parsers can name them.
+  * @return 0 if success. */
+static int writeMembers( FILE* file, json_t const* shape, char const* path, int level ) {
+    static char const* const types[] = { "int64_t", "double", "char const*", "bool" };
+    for( json_t const* field = json_getChild( shape ); field; field = json_getSibling( field ) ) {
+        int const type = fieldType( field );
+        if ( type < 0 ) {
+            fprintf( stderr, "The type of '%s' in '%s' is not valid.\n", json_getName( field ), path );
+            return -1;
+        }
+        indent( file, level );
+        if ( type == OBJECT ) {
+            char nested[ 512 ];
+            if ( joinPath( nested, path, json_getName( field ) ) ) return -1;
+            fputs( "struct ", file );
+            writeIdentifier( file, nested );
+            fputs( "_s {\n", file );
+            if ( writeMembers( file, field, nested, level + 1 ) ) return -1;
+            indent( file, level );
+            fputs( "} ", file );
+        }
+        else fprintf( file, "%s ", types[ type ] );
+        writeIdentifier( file, json_getName( field ) );
+        fputs( ";\n", file );
+    }
+    return 0;
+}
+
+/** Compare two fields by the length of their names and then by their first character. */
+static int compareFields( void const* a, void const* b ) {
+    char const* const na = json_getName( *(json_t const* const*)a );
+    char const* const nb = json_getName( *(json_t const* const*)b );
+    size_t const la = strlen( na );
+    size_t const lb = strlen( nb );
+    if ( la != lb ) return la < lb? -1: 1;
+    return (unsigned char)*na - (unsigned char)*nb;
+}
+
+/** Write the code that parses the value of a field into its member. The first
+  * character of the value is checked before it is converted, so a value of an
+  * unexpected type is parsed as an unknown property and the member is left zero.
+  * So is an integer field with a real value. */
+static void writeField( FILE* file, json_t const* field, char const* path, int level ) {
+    static char const* const scans[] = { "json_scanInteger( ptr, parser, ", "json_scanReal( ptr, parser, ",
+                                         "json_scanText( ptr, parser, ", "json_scanBoolean( ptr, " };
+    static char const* const guards[] = { "*ptr == '-' || ( *ptr >= '0' && *ptr <= '9' )",
+                                          "*ptr == '-' || ( *ptr >= '0' && *ptr <= '9' )",
+                                          "*ptr == '\\\"'", "*ptr == 't' || *ptr == 'f'", "*ptr == '{'" };
+    char const* const name = json_getName( field );
+    int const type = fieldType( field );
+    indent( file, level );
+    fputs( "if ( !memcmp( name, ", file );
+    writeLiteral( file, name );
+    fprintf( file, ", %u )", (unsigned)strlen( name ) );
+    bool const grouped = type == INTEGER || type == REAL || type == BOOLEAN;
+    fputs( grouped? " && ( ": " && ", file );
+    fputs( guards[ type ], file );
+    fputs( grouped? " ) ) {\n": " ) {\n", file );
+    indent( file, level + 1 );
+    if ( type == INTEGER ) fputs( "char* const next = ", file );
+    else fputs( "ptr = ", file );
+    if ( type == OBJECT ) {
+        writeIdentifier( file, path );
+        fputc( '_', file );
+        writeIdentifier( file, name );
+        fputs( "_object( ptr, parser, ", file );
+    }
+    else fputs( scans[ type ], file );
+    fputs( "&out->", file );
+    writeIdentifier( file, name );
+    fputs( " );\n", file );
+    if ( type == INTEGER ) {
+        indent( file, level + 1 );
+        fputs( "if ( next ) {\n", file );
+        indent( file, level + 2 );
+        fputs( "ptr = next;\n", file );
+        indent( file, level + 2 );
+        fputs( "continue;\n", file );
+        indent( file, level + 1 );
+        fputs( "}\n", file );
+    }
+    else {
+        indent( file, level + 1 );
+        fputs( "continue;\n", file );
+    }
+    indent( file, level );
+    fputs( "}\n", file );
+}
+
+/** Write the function that parses an object of a message and, before it,
+  * the ones of its nested objects.
+  * @param file The C file.
+  * @param shape The object of the schema with the fields.
+  * @param path The name of the message type and of the nested fields.
+  * @param nested true for a nested object, false for a message.
+  * @return 0 if success. */
+static int writeParser( FILE* file, json_t const* shape, char const* path, bool nested ) {
+    json_t const* fields[ MAX_FIELDS ];
+    size_t qty = 0;
+    for( json_t const* field = json_getChild( shape ); field; field = json_getSibling( field ) ) {
+        if ( qty == MAX_FIELDS ) {
+            fprintf( stderr, "'%s' has more than %d fields.\n", path, MAX_FIELDS );
+            return -1;
+        }
+        fields[ qty++ ] = field;
+        if ( fieldType( field ) == OBJECT ) {
+            char nested[ 512 ];
+            if ( joinPath( nested, path, json_getName( field ) ) ) return -1;
+            if ( writeParser( file, field, nested, true ) ) return -1;
+        }
+    }
+    qsort( fields, qty, sizeof *fields, compareFields );
+
+    fputs( "/** Parse the properties of an object from its '{' to its '}'. */\nstatic char* ", file );
+    writeIdentifier( file, path );
+    fputs( nested? "_object( char* ptr, jsonParser_t* parser, struct ": "_object( char* ptr, jsonParser_t* parser, ", file );
+    writeIdentifier( file, path );
+    fputs( nested? "_s* out ) {\n": "_t* out ) {\n", file );
+    fputs( "    for( ++ptr;; ) {\n"
+           "        if ( !ptr ) return 0;\n"
+           "        ptr = json_scanBlank( ptr );\n"
+           "        if ( !ptr ) return 0;\n"
+           "        if ( *ptr == ',' ) {\n"
+           "            ++ptr;\n"
+           "            continue;\n"
+           "        }\n"
+           "        if ( *ptr == '}' ) return ++ptr;\n"
+           "        if ( *ptr != '\\\"' ) return 0;\n"
+           "        char const* const name = ptr + 1;\n"
+           "        size_t len;\n"
+           "        ptr = json_scanName( ptr, parser, &len );\n"
+           "        if ( !ptr ) return 0;\n"
+           "        switch( len ) {\n", file );
+    for( size_t i = 0; i < qty; ) {
+        size_t const len = strlen( json_getName( fields[i] ) );
+        size_t end = i;
+        while( end < qty && strlen( json_getName( fields[end] ) ) == len ) ++end;
+        fprintf( file, "            case %u:\n", (unsigned)len );
+        bool const byFirst = end - i > 1 && len > 0 && *json_getName( fields[i] ) != *json_getName( fields[end - 1] );
+        if ( byFirst ) {
+            fputs( "                switch( name[0] ) {\n", file );
+            while( i < end ) {
+                char const first = *json_getName( fields[i] );
+                fputs( "                    case ", file );
+                fprintf( file, isprint( (unsigned char)first ) && first != '\'' && first != '\\'? "'%c'": "%d", first );
+                fputs( ":\n", file );
+                for( ; i < end && *json_getName( fields[i] ) == first; ++i )
+                    writeField( file, fields[i], path, 6 );
+                fputs( "                        break;\n", file );
+            }
+            fputs( "                }\n", file );
+        }
+        else for( ; i < end; ++i )
+            writeField( file, fields[i], path, 4 );
+        fputs( "                break;\n", file );
+    }
+    fputs( "        }\n"
+           "        json_t const* unknown;\n"
+           "        ptr = json_scanValue( ptr, parser, &unknown );\n"
+           "    }\n"
+           "}\n\n", file );
+    return 0;
+}
+
+/** Write the declarations of the messages in the header. */
+static int writeHeader( FILE* file, json_t const* schema, char const* name, char const* source ) {
+    fprintf( file, "\n/* Generated by json-codegen from %s. Do not edit. */\n\n", source );
+    fputs( "#ifndef _", file );
+    for( char const* ch = name; *ch; ++ch )
+        fputc( isalnum( (unsigned char)*ch )? toupper( (unsigned char)*ch ): '_', file );
+    fputs( "_H_\n#define _", file );
+    for( char const* ch = name; *ch; ++ch )
+        fputc( isalnum( (unsigned char)*ch )? toupper( (unsigned char)*ch ): '_', file );
+    fputs( "_H_\n\n#include \"tiny-json.h\"\n\n#ifdef __cplusplus\nextern \"C\" {\n#endif\n", file );
+    for( json_t const* msg = json_getChild( schema ); msg; msg = json_getSibling( msg ) ) {
+        if ( json_getType( msg ) != JSON_OBJ ) {
+            fprintf( stderr, "The message type '%s' is not an object.\n", json_getName( msg ) );
+            return -1;
+        }
+        fputs( "\n/** Fields of a message ", file );
+        fputs( json_getName( msg ), file );
+        fputs( ". */\ntypedef struct ", file );
+        writeIdentifier( file, json_getName( msg ) );
+        fputs( "_s {\n", file );
+        if ( writeMembers( file, msg, json_getName( msg ), 1 ) ) return -1;
+        fputs( "} ", file );
+        writeIdentifier( file, json_getName( msg ) );
+        fputs( "_t;\n\n", file );
+        fputs( "/** Parse a JSON object into its fields. The fields that are missing or null\n"
+               "  * are zero, the texts point into the string, and the other properties are\n"
+               "  * parsed with the generic parser and dropped.\n"
+               "  * @param str String pointer with a JSON object. It will be modified.\n"
+               "  * @param out The fields.\n"
+               "  * @param pool Pool for the properties that are not fields.\n"
+               "  * @return true if success. */\nbool ", file );
+        writeIdentifier( file, json_getName( msg ) );
+        fputs( "_parse( char* str, ", file );
+        writeIdentifier( file, json_getName( msg ) );
+        fputs( "_t* out, jsonPool_t* pool );\n", file );
+    }
+    fputs( "\n#ifdef __cplusplus\n}\n#endif\n\n#endif\n", file );
+    return 0;
+}
+
+/** Write the parsers of the messages. */
+static int writeSource( FILE* file, json_t const* schema, char const* name, char const* source ) {
+    fprintf( file, "\n/* Generated by json-codegen from %s. Do not edit. */\n\n", source );
+    fprintf( file, "#include <string.h>\n#include \"%s.h\"\n\n", name );
+    for( json_t const* msg = json_getChild( schema ); msg; msg = json_getSibling( msg ) ) {
+        if ( writeParser( file, msg, json_getName( msg ), false ) ) return -1;
+        fputs( "/* Parse a JSON object into its fields. */\nbool ", file );
+        writeIdentifier( file, json_getName( msg ) );
+        fputs( "_parse( char* str, ", file );
+        writeIdentifier( file, json_getName( msg ) );
+        fputs( "_t* out, jsonPool_t* pool ) {\n", file );
+        fputs( "    jsonParser_t parser;\n"
+               "    json_initScan( &parser, str, pool );\n"
+               "    memset( out, 0, sizeof *out );\n"
+               "    char* const ptr = json_scanBlank( str );\n"
+               "    return ptr && *ptr == '{' && ", file );
+        writeIdentifier( file, json_getName( msg ) );
+        fputs( "_object( ptr, &parser, out );\n}\n\n", file );
+    }
+    return 0;
+}
+
+/** Read a whole file in a null-terminated string. */
+static char* readFile( char const* path ) {
+    FILE* const file = fopen( path, "rb" );
+    if ( !file ) return NULL;
+    char* str = NULL;
+    if ( !fseek( file, 0, SEEK_END ) ) {
+        long const len = ftell( file );
+        if ( len >= 0 && !fseek( file, 0, SEEK_SET ) && ( str = malloc( (size_t)len + 1 ) ) ) {
+            if ( fread( str, 1, (size_t)len, file ) == (size_t)len ) str[ len ] = '\0';
+            else {
+                free( str );
+                str = NULL;
+            }
+        }
+    }
+    fclose( file );
+    return str;
+}
+
+/** Open the output file with a name and an extension. */
+static FILE* openOutput( char const* name, char const* ext ) {
+    char path[ 512 ];
+    snprintf( path, sizeof path, "%s%s", name, ext );
+    FILE* const file = fopen( path, "w" );
+    if ( !file ) fprintf( stderr, "Cannot write '%s'.\n", path );
+    return file;
+}
+
+int main( int argc, char** argv ) {
+    if ( argc != 3 ) {
+        fprintf( stderr, "Usage: %s schema.json name\n", argv[0] );
+        return EXIT_FAILURE;
+    }
+    char* const str = readFile( argv[1] );
+    if ( !str ) {
+        fprintf( stderr, "Cannot read '%s'.\n", argv[1] );
+        return EXIT_FAILURE;
+    }
+    static json_t mem[ MAX_NODES ];
+    json_t const* const schema = json_create( str, mem, MAX_NODES );
+    if ( !schema || json_getType( schema ) != JSON_OBJ ) {
+        fprintf( stderr, "'%s' is not a valid schema.\n", argv[1] );
+        return EXIT_FAILURE;
+    }
+    char const* const name = argv[2];
+    char const* base = strrchr( name, '/' );
+    base = base? base + 1: name;
+    FILE* const h = openOutput( name, ".h" );
+    FILE* const c = h? openOutput( name, ".c" ): NULL;
+    int const err = !c || writeHeader( h, schema, base, argv[1] ) || writeSource( c, schema, base, argv[1] );
+    if ( h ) fclose( h );
+    if ( c ) fclose( c );
+    free( str );
+    return err? EXIT_FAILURE: EXIT_SUCCESS;
+}
@@ -0,0 +1,168 @@
+
+/*
+
+<https://github.com/rafagafe/tiny-json>
+     
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2016-2018 Rafa Garcia <rafagarcia77@gmail.com>.
+
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+    
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include "../tiny-json.h"
+#include "../tiny-json-shared.h"
+
+/* The tests that need C11 or threads: the pool shared by threads and the
+   parse of the parts of an array on POSIX threads, which ThreadSanitizer
+   follows. */
+
+/* The same test "framework" as tests.c, which counts the checks. */
+#define done() return 0
+#define fail() return __LINE__
+extern int checkqty;
+#define check( x ) do { ++checkqty; if (!(x)) fail(); } while ( 0 )
+
+int shared( void ) {
+    json_t mem[32];
+    jsonShared_t pool;
+    check( !json_initShared( &pool, mem, 32, 0 ) );
+    check( json_initShared( &pool, mem, 32, 8 ) );
+    jsonContext_t ctx[2];
+    json_initContext( &ctx[0], &pool );
+    json_initContext( &ctx[1], &pool );
+    char str[3][64];
+    strcpy( str[0], "{\"a\":1,\"b\":[1,2,3],\"c\":{\"d\":true}}" );
+    strcpy( str[1], "[1,2,3,4,5,6,7,8,9,10,11,12,13]" );
+    json_t const* first = json_createWithContext( str[0], &ctx[0], NULL, 0 );
+    check( first );
+    json_t const* second = json_createWithPool( str[1], &ctx[1].pool );
+    check( second );
+    check( ctx[0].first != ctx[1].first );
+    strcpy( str[2], "{\"e\":[1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16]}" );
+    check( !json_createWithContext( str[2], &ctx[0], NULL, 0 ) );
+    check( !strcmp( "true", json_getPropertyValue( json_getProperty( first, "c" ), "d" ) ) );
+    json_releaseContext( &ctx[1] );
+    strcpy( str[2], "{\"e\":[1,2,3,4,5,6,7,8,9,10]}" );
+    json_t const* third = json_createWithContext( str[2], &ctx[0], NULL, 0 );
+    check( third );
+    check( !strcmp( "true", json_getPropertyValue( json_getProperty( first, "c" ), "d" ) ) );
+    check( !strcmp( "10", json_getValue( json_getChild( json_getProperty( third, "e" ) ) + 9 ) ) );
+    json_releaseContext( &ctx[0] );
+    strcpy( str[1], "[1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,21,22,23,24,25,26,27,28,29,30]" );
+    check( json_createWithContext( str[1], &ctx[1], NULL, 0 ) );
+    done();
+}
+
+/** Static storage of the json properties of a part. */
+struct partPool {
+    jsonPool_t pool;
+    json_t* mem;
+    unsigned qty;
+    unsigned next;
+};
+
+static json_t* partAlloc( jsonPool_t* pool ) {
+    struct partPool* spool = json_containerOf( pool, struct partPool, pool );
+    if ( spool->next >= spool->qty ) return NULL;
+    return spool->mem + spool->next++;
+}
+
+static json_t* partInit( jsonPool_t* pool ) {
+    struct partPool* spool = json_containerOf( pool, struct partPool, pool );
+    spool->next = 0;
+    return partAlloc( pool );
+}
+
+/** Work of a thread of a parallel parse. */
+struct partJob {
+    jsonSplit_t* split;
+    unsigned int i;
+    jsonPool_t* pool;
+    bool ok;
+};
+
+static void* scanJob( void* arg ) {
+    struct partJob* const job = arg;
+    json_scanPart( job->split, job->i );
+    return NULL;
+}
+
+static void* parseJob( void* arg ) {
+    struct partJob* const job = arg;
+    job->ok = json_parsePart( job->split, job->i, job->pool );
+    return NULL;
+}
+
+/** Run a step of a parallel parse with a thread per part. */
+static bool runJobs( void* (*func)( void* ), struct partJob jobs[], unsigned int qty ) {
+    pthread_t threads[ JSON_MAXPARTS ];
+    unsigned int i;
+    for( i = 0; i < qty; ++i )
+        if ( pthread_create( &threads[i], NULL, func, &jobs[i] ) ) return false;
+    for( i = 0; i < qty; ++i )
+        pthread_join( threads[i], NULL );
+    return true;
+}
+
+int threads( void ) {
+    enum { elements = 4000, parts = 8, nodes = 3 * elements };
+    static char const* const items[] = {
+        "{\"id\":%u,\"text\":\"a \\\"b\\\" \\\\ c\\n\"}", "%u", "\"\\u00e9%u\\t\"", "true", "-%u.5e-1", "[%u,null]"
+    };
+    static char doc[ 32 * elements ];
+    static char str[ sizeof doc ];
+    static json_t ref[ nodes ];
+    static json_t mem[ parts ][ nodes ];
+    size_t len = 0;
+    unsigned int i;
+    doc[ len++ ] = '[';
+    for( i = 0; i < elements; ++i ) {
+        if ( i ) len += (size_t)sprintf( doc + len, i % 7? ",": " ,\n" );
+        len += (size_t)sprintf( doc + len, items[ i % 6 ], i );
+    }
+    doc[ len++ ] = ']';
+    doc[ len ] = '\0';
+    memcpy( str, doc, len + 1 );
+    json_t const* const reference = json_create( doc, ref, nodes );
+    check( reference );
+    static jsonSplit_t split;
+    unsigned int const qty = json_splitArray( &split, str, len, parts, 0 );
+    check( qty == parts );
+    struct partPool pools[ parts ];
+    struct partJob jobs[ parts ];
+    for( i = 0; i < qty; ++i ) {
+        struct partPool const pool = { { partInit, partAlloc }, mem[i], nodes, 0 };
+        pools[i] = pool;
+        struct partJob const job = { &split, i, &pools[i].pool, false };
+        jobs[i] = job;
+    }
+    check( runJobs( scanJob, jobs, qty ) );
+    check( json_findElements( &split ) );
+    check( runJobs( parseJob, jobs, qty ) );
+    for( i = 0; i < qty; ++i )
+        check( jobs[i].ok );
+    json_t const* const json = json_joinParts( &split );
+    check( json && json_equal( json, reference ) );
+    done();
+}
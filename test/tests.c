@@ -31,7 +31,9 @@
 #include <string.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <limits.h>
 #include "../tiny-json.h"
+#include "order-parser.h"
 
 
 
@@ -39,7 +41,7 @@
 
 #define done() return 0
 #define fail() return __LINE__
-static int checkqty = 0;
+int checkqty = 0;
 #define check( x ) do { ++checkqty; if (!(x)) fail(); } while ( 0 )
 
 struct test {
@@ -47,6 +49,10 @@ struct test {
     char const* name;
 };
 
+/* The tests that run threads are built as C11. See tests-shared.c. */
+int shared( void );
+int threads( void );
+
 static int test_suit( struct test const* tests, int numtests ) {
     printf( "%s", "\n\nTests:\n" );
     int failed = 0;
@@ -363,6 +369,1182 @@ int badformat( void ) {
     done();
 }
 
+struct staticPool {
+    jsonPool_t pool;
+    json_t* mem;
+    unsigned qty;
+    unsigned next;
+};
+
+static json_t* staticPoolAlloc( jsonPool_t* pool ) {
+    struct staticPool* spool = json_containerOf( pool, struct staticPool, pool );
+    if ( spool->next >= spool->qty ) return NULL;
+    return spool->mem + spool->next++;
+}
+
+static json_t* staticPoolInit( jsonPool_t* pool ) {
+    struct staticPool* spool = json_containerOf( pool, struct staticPool, pool );
+    spool->next = 0;
+    return staticPoolAlloc( pool );
+}
+
+static int keys( void ) {
+    jsonKey_t mem[8];
+    char buf[32];
+    jsonKeys_t keys;
+    json_initKeys( &keys, mem, sizeof mem / sizeof *mem, buf, sizeof buf );
+
+    char const* name = json_internKey( &keys, "name" );
+    check( name );
+    check( !strcmp( name, "name" ) );
+    check( name == json_internKey( &keys, "name" ) );
+    check( name == json_findKey( &keys, "name", json_hashKey( "name" ) ) );
+    check( !json_findKey( &keys, "age", json_hashKey( "age" ) ) );
+
+    json_t nodes[4];
+    struct staticPool spool = { { staticPoolInit, staticPoolAlloc }, nodes, 4, 0 };
+    {
+        char str[] = "{\"name\":\"peter\",\"age\":32}";
+        json_t const* json = json_createWithKeys( str, &spool.pool, &keys );
+        check( json );
+        char const* age = json_findKey( &keys, "age", json_hashKey( "age" ) );
+        check( age );
+        json_t const* field = json_getInternedProperty( json, age );
+        check( field );
+        check( json_getName( field ) == age );
+        check( JSON_INTEGER == json_getType( field ) );
+        check( 32 == json_getInteger( field ) );
+        field = json_getInternedProperty( json, name );
+        check( field );
+        check( !strcmp( "peter", json_getValue( field ) ) );
+    }
+    {
+        char str[] = "{\"age\":40,\"name\":\"john\"}";
+        json_t const* json = json_createWithKeys( str, &spool.pool, &keys );
+        check( json );
+        check( json_getName( json_getChild( json ) ) == json_internKey( &keys, "age" ) );
+        json_t const* field = json_getInternedProperty( json, name );
+        check( field );
+        check( !strcmp( "john", json_getValue( field ) ) );
+    }
+    {
+        char str[] = "{\"a_very_long_property_name\":1}";
+        json_t const* json = json_createWithKeys( str, &spool.pool, &keys );
+        check( !json );
+    }
+    done();
+}
+
+static int numbers( void ) {
+    json_t pool[16];
+    unsigned const qty = sizeof pool / sizeof *pool;
+    char str[] = "[ 0, -7, 12345678, 1700000000123, -99999999999999999, 123456789012345678,"
+                 "  -9223372036854775807, 3.5, -0.125, 1e22, 12.5E-3, 0.1, 1.7976931348623157e308,"
+                 "  123456789.12345678 ]";
+    json_t const* json = json_create( str, pool, qty );
+    check( json );
+    static int64_t const integers[] = {
+        0, -7, 12345678, 1700000000123, -99999999999999999, 123456789012345678,
+        -9223372036854775807
+    };
+    static double const reals[] = {
+        3.5, -0.125, 1e22, 12.5E-3, 0.1, 1.7976931348623157e308, 123456789.12345678
+    };
+    unsigned const ints = sizeof integers / sizeof *integers;
+    unsigned const qtyreals = sizeof reals / sizeof *reals;
+    json_t const* element = json_getChild( json );
+    for( unsigned i = 0; i < ints; ++i, element = json_getSibling( element ) ) {
+        check( element );
+        check( JSON_INTEGER == json_getType( element ) );
+        check( integers[i] == json_getInteger( element ) );
+    }
+    for( unsigned i = 0; i < qtyreals; ++i, element = json_getSibling( element ) ) {
+        check( element );
+        check( JSON_REAL == json_getType( element ) );
+        check( reals[i] == json_getReal( element ) );
+    }
+    check( !element );
+    {
+        char str[] = "[ 12345678901234567890123 ]";
+        check( !json_create( str, pool, qty ) );
+    }
+    {
+        char str[] = "[ 1234567890123456x ]";
+        check( !json_create( str, pool, qty ) );
+    }
+    {
+        char str[] = "[ 9223372036854775807 ]";
+        check( json_create( str, pool, qty ) );
+        check( !strcmp( "9223372036854775807", str + 2 ) );
+    }
+    done();
+}
+
+static int consecutive( void ) {
+    json_t nodes[8];
+    struct staticPool spool = { { staticPoolInit, staticPoolAlloc }, nodes, 8, 0 };
+    {
+        char str[] = "{\"a\":1}[2,3] {\"b\":true}\n";
+        char* ptr = str;
+        json_t const* json = json_createNext( ptr, &spool.pool, &ptr );
+        check( json );
+        check( 1 == json_getInteger( json_getProperty( json, "a" ) ) );
+        check( ptr == str + 7 );
+        json = json_createNext( ptr, &spool.pool, &ptr );
+        check( json );
+        check( JSON_ARRAY == json_getType( json ) );
+        check( 3 == json_getInteger( json_getSibling( json_getChild( json ) ) ) );
+        json = json_createNext( ptr, &spool.pool, &ptr );
+        check( json );
+        check( json_getBoolean( json_getProperty( json, "b" ) ) );
+        json = json_createNext( ptr, &spool.pool, &ptr );
+        check( !json );
+        check( ptr && *ptr == '\0' );
+    }
+    {
+        char str[] = "{\"a\":1}[2,3]{\"b\":true}{\"c\":x}";
+        json_t const* roots[4];
+        char* end;
+        size_t const qty = json_createBatch( str, &spool.pool, roots, 4, &end );
+        check( 3 == qty );
+        check( !end );
+        check( 1 == json_getInteger( json_getProperty( roots[0], "a" ) ) );
+        check( 2 == json_getInteger( json_getChild( roots[1] ) ) );
+        check( json_getBoolean( json_getProperty( roots[2], "b" ) ) );
+    }
+    {
+        char str[] = "[1][2][3]";
+        json_t const* roots[2];
+        char* end;
+        check( 2 == json_createBatch( str, &spool.pool, roots, 2, &end ) );
+        check( end == str + 6 );
+        check( 2 == json_getInteger( json_getChild( roots[1] ) ) );
+    }
+    done();
+}
+
+static int packed( void ) {
+    json_t nodes[16];
+    struct staticPool spool = { { staticPoolInit, staticPoolAlloc }, nodes, 16, 0 };
+    {
+        char str[] = "{\"ints\":[1,-2,3,4,5,6,7,8,9,10,1700000000123],"
+                     "\"reals\":[ 1, 2.5, -3e2 ],"
+                     "\"mixed\":[ 1, \"a\" ],"
+                     "\"nested\":[[1,2],[]]}";
+        json_t const* json = json_createWithOptions( str, &spool.pool, NULL, JSON_PACK_NUMBERS );
+        check( json );
+
+        json_t const* ints = json_getProperty( json, "ints" );
+        check( ints );
+        check( JSON_ARRAY == json_getType( ints ) );
+        check( JSON_INTEGER == json_getArrayType( ints ) );
+        check( !json_getChild( ints ) );
+        check( 11 == json_getArrayLength( ints ) );
+        int64_t const* i64 = json_getArrayData( ints );
+        check( i64 );
+        check( 1 == i64[0] && -2 == i64[1] && 10 == i64[9] );
+        check( 1700000000123 == i64[10] );
+
+        json_t const* reals = json_getProperty( json, "reals" );
+        check( reals );
+        check( JSON_REAL == json_getArrayType( reals ) );
+        check( 3 == json_getArrayLength( reals ) );
+        double const* f64 = json_getArrayData( reals );
+        check( 1.0 == f64[0] && 2.5 == f64[1] && -3e2 == f64[2] );
+
+        json_t const* mixed = json_getProperty( json, "mixed" );
+        check( mixed );
+        check( JSON_ARRAY == json_getArrayType( mixed ) );
+        check( !json_getArrayData( mixed ) );
+        json_t const* element = json_getChild( mixed );
+        check( element );
+        check( 1 == json_getInteger( element ) );
+        element = json_getSibling( element );
+        check( element );
+        check( !strcmp( "a", json_getValue( element ) ) );
+
+        json_t const* nested = json_getProperty( json, "nested" );
+        check( nested );
+        check( JSON_ARRAY == json_getArrayType( nested ) );
+        element = json_getChild( nested );
+        check( element );
+        check( JSON_INTEGER == json_getArrayType( element ) );
+        check( 2 == json_getArrayLength( element ) );
+        element = json_getSibling( element );
+        check( element );
+        check( JSON_ARRAY == json_getArrayType( element ) );
+        check( !json_getChild( element ) );
+    }
+    {
+        char str[] = "[ 9223372036854775808 ]";
+        check( !json_createWithOptions( str, &spool.pool, NULL, JSON_PACK_NUMBERS ) );
+    }
+    {
+        /* An array that is not packed takes as many json properties as without the option. */
+        char str[] = "[1,2,3,4,5,6,7,8,9,10,\"x\"]";
+        json_t small[12];
+        struct staticPool exact = { { staticPoolInit, staticPoolAlloc }, small, 12, 0 };
+        json_t const* const json = json_createWithOptions( str, &exact.pool, NULL, JSON_PACK_NUMBERS );
+        check( json && JSON_ARRAY == json_getArrayType( json ) && 12 == exact.next );
+        json_t const* element = json_getChild( json );
+        unsigned int i;
+        for( i = 1; i <= 10; ++i, element = json_getSibling( element ) )
+            check( element && i == json_getInteger( element ) );
+        check( element && JSON_TEXT == json_getType( element ) );
+    }
+    done();
+}
+
+static int columns( void ) {
+    json_t pool[32];
+    unsigned const qty = sizeof pool / sizeof *pool;
+    char str[] = "[{\"id\":1,\"price\":2.5,\"name\":\"a\",\"ok\":true},"
+                 " {\"id\":2,\"price\":3,\"name\":\"b\",\"ok\":false},"
+                 " {\"name\":\"c\",\"ok\":true,\"id\":3,\"price\":-1.25},"
+                 " {\"id\":4,\"name\":\"d\"}]";
+    json_t const* json = json_create( str, pool, qty );
+    check( json );
+
+    double prices[4];
+    check( 3 == json_extractColumn( json, "price", JSON_REAL, prices, 4 ) );
+    check( 2.5 == prices[0] && 3.0 == prices[1] && -1.25 == prices[2] );
+    check( 2 == json_extractColumn( json, "price", JSON_REAL, prices, 2 ) );
+
+    int64_t ids[4];
+    char const* names[4];
+    bool oks[4];
+    jsonColumn_t cols[] = {
+        { "id",   JSON_INTEGER, ids,   0 },
+        { "name", JSON_TEXT,    names, 0 },
+        { "ok",   JSON_BOOLEAN, oks,   0 },
+    };
+    check( 3 == json_extractColumns( json, cols, 3, 4 ) );
+    check( 1 == ids[0] && 2 == ids[1] && 3 == ids[2] );
+    check( !strcmp( names[0], "a" ) && !strcmp( names[2], "c" ) );
+    check( oks[0] && !oks[1] && oks[2] );
+    check( 0 == cols[0].pos && 1 == cols[1].pos );
+
+    check( 0 == json_extractColumn( json, "name", JSON_INTEGER, ids, 4 ) );
+    done();
+}
+
+static int validate( void ) {
+    static char const* const strs[] = {
+        "{}", "[]", " {\"a\":[{},{}]} ", "{\"qwerty\":false,}", "{,\"a\":1, , \"b\":2,,,,}",
+        "{\"a\":\"\\tThis \\\"text\\\" \\u00e8\\/\"}", "{\"a\":\"\\x\"}", "{\"a\":\"\\u12G4\"}",
+        "{\"var:true}", "{\"var\":tr}", "{\"var\":true", "{\"var\":true} text outside json",
+        "{\"var\":truep}", "{\"var\":0s}", "{\"var\":9223372036854775808}", "{\"var\":9223372036854775807}",
+        "{\"var\":-9223372036854775809}", "{\"var\":-9223372036854775808}", "{\"var\":,9}",
+        "{\"var\":}", "[1 2]", "[1}", "{\"a\":1]", "[01]", "[-]", "[1.]", "[1.5e]", "[1.5e+7,-0.0E-2]",
+        "[\"x\"\"y\"]", "{\"a\" : [ true , false , null ] }", "[[[[[]]]]]", "[[[[[]]]]", "x", "",
+    };
+    for( unsigned i = 0; i < sizeof strs / sizeof *strs; ++i ) {
+        char str[64];
+        json_t pool[16];
+        size_t const len = strlen( strs[i] );
+        for( size_t j = 0; j <= len; ++j ) {
+            memcpy( str, strs[i], j );
+            str[j] = '\0';
+            bool const valid = json_validate( strs[i], j );
+            check( valid == ( NULL != json_create( str, pool, 16 ) ) );
+        }
+    }
+    {
+        char const str[] = "{\"long text without escapes\":\"0123456789abcdefghijklmnopqrstuvwxyz\"}";
+        check( json_validate( str, sizeof str - 1 ) );
+        check( !json_validate( str, sizeof str - 2 ) );
+        check( !json_validate( str, 20 ) );
+    }
+    done();
+}
+
+static int minify( void ) {
+    {
+        char str[] = "{\n\t\"first name\" : \"Bidhan \\\" x\\\\\",\r\n\t\"age\": 40 ,\f"
+                     "  \"list\" : [ 1, 2 , \"  a  b  \" , { } ] \n}\n";
+        char const expected[] = "{\"first name\":\"Bidhan \\\" x\\\\\",\"age\":40,"
+                                "\"list\":[1,2,\"  a  b  \",{}]}";
+        size_t const len = json_minify( str );
+        check( len == sizeof expected - 1 );
+        check( !strcmp( str, expected ) );
+        json_t pool[8];
+        json_t const* json = json_create( str, pool, 8 );
+        check( json );
+        check( !strcmp( "Bidhan \" x\\", json_getPropertyValue( json, "first name" ) ) );
+    }
+    {
+        char str[] = "   ";
+        check( 0 == json_minify( str ) );
+        check( !strcmp( str, "" ) );
+    }
+    {
+        char str[] = "[\"unterminated \\";
+        check( sizeof str - 1 == json_minify( str ) );
+    }
+    done();
+}
+
+static int equality( void ) {
+    json_t mem[3][32];
+    {
+        char a[] = "{\"a\":1,\"b\":[1,2.5,{\"c\":\"x\",\"d\":null}],\"e\":true}";
+        char b[] = "{ \"e\": true, \"b\": [ 1.0, 25e-1, { \"d\": null, \"c\": \"x\" } ], \"a\": 10e-1 }";
+        json_t const* ja = json_create( a, mem[0], 32 );
+        json_t const* jb = json_create( b, mem[1], 32 );
+        check( ja && jb );
+        check( json_equal( ja, jb ) );
+        check( json_equal( jb, ja ) );
+        check( json_hash( ja ) == json_hash( jb ) );
+        check( json_equal( json_getProperty( ja, "b" ), json_getProperty( jb, "b" ) ) );
+        check( !json_equal( json_getProperty( ja, "a" ), json_getProperty( ja, "e" ) ) );
+    }
+    {
+        static char const* const different[] = {
+            "{\"a\":[2,1]}", "{\"a\":[1,2,3]}", "{\"a\":[1,\"2\"]}", "{\"a\":[1,2],\"b\":0}",
+            "{\"b\":[1,2]}", "{\"a\":[1,2.5]}", "{\"a\":{}}", "{\"a\":[1,[2]]}"
+        };
+        char a[] = "{\"a\":[1,2]}";
+        json_t const* ja = json_create( a, mem[0], 32 );
+        check( ja );
+        unsigned int i;
+        for( i = 0; i < sizeof different / sizeof *different; ++i ) {
+            char b[32];
+            strcpy( b, different[i] );
+            json_t const* jb = json_create( b, mem[1], 32 );
+            check( jb );
+            check( !json_equal( ja, jb ) );
+            check( !json_equal( jb, ja ) );
+            check( json_hash( ja ) != json_hash( jb ) );
+        }
+    }
+    {
+        char a[] = "{\"a\":1,\"b\":2}";
+        char b[] = "{\"a\":2,\"b\":1}";
+        json_t const* ja = json_create( a, mem[0], 32 );
+        json_t const* jb = json_create( b, mem[1], 32 );
+        check( ja && jb );
+        check( !json_equal( ja, jb ) );
+        check( json_hash( ja ) != json_hash( jb ) );
+    }
+    {
+        char a[] = "{\"v\":[1,2,3.0],\"w\":[1.5,-2]}";
+        char b[] = "{\"w\":[1.5,-2],\"v\":[1,2,3]}";
+        struct staticPool spool = { { staticPoolInit, staticPoolAlloc }, mem[2], 32, 0 };
+        json_t const* ja = json_create( a, mem[0], 32 );
+        json_t const* jb = json_createWithOptions( b, &spool.pool, NULL, JSON_PACK_NUMBERS );
+        check( ja && jb );
+        check( JSON_INTEGER == json_getArrayType( json_getProperty( jb, "v" ) ) );
+        check( json_equal( ja, jb ) );
+        check( json_equal( jb, ja ) );
+        check( json_hash( ja ) == json_hash( jb ) );
+    }
+    {
+        enum { depth = 30 };
+        char a[ 2 * depth + 1 ];
+        char b[ 2 * depth + 1 ];
+        unsigned int i;
+        for( i = 0; i < depth; ++i ) {
+            a[i] = '[';
+            a[ 2 * depth - 1 - i ] = ']';
+        }
+        a[ 2 * depth ] = '\0';
+        strcpy( b, a );
+        json_t const* ja = json_create( a, mem[0], 32 );
+        json_t const* jb = json_create( b, mem[1], 32 );
+        check( ja && jb );
+        check( json_equal( ja, jb ) );
+        check( json_hash( ja ) == json_hash( jb ) );
+    }
+    done();
+}
+
+static int deep( void ) {
+    enum { levels = 3000, qty = 3 * levels };
+    static char doc[ 8 * levels ];
+    static char str[3][ 8 * levels ];
+    static char out[ 8 * levels ];
+    static char buf[ 24 * levels ];
+    static json_t mem[4][ qty ];
+    size_t len = 0;
+    unsigned int i;
+    for( i = 0; i < levels; ++i ) {
+        char const* const open = i % 2? "[1,": "{\"k\":";
+        strcpy( doc + len, open );
+        len += strlen( open );
+    }
+    size_t const zero = len;
+    doc[ len++ ] = '0';
+    for( i = levels; i--; )
+        doc[ len++ ] = i % 2? ']': '}';
+    doc[ len ] = '\0';
+    strcpy( str[0], doc );
+    strcpy( str[1], doc );
+    strcpy( str[2], doc );
+    str[2][ zero ] = '1';
+    json_t const* a = json_create( str[0], mem[0], qty );
+    struct staticPool spool = { { staticPoolInit, staticPoolAlloc }, mem[1], qty, 0 };
+    json_t const* b = json_createWithOptions( str[1], &spool.pool, NULL, JSON_SORT_KEYS );
+    json_t const* c = json_create( str[2], mem[2], qty );
+    check( a && b && c );
+    check( json_equal( a, a ) );
+    check( json_equal( a, b ) && json_equal( b, a ) );
+    check( json_hash( a ) == json_hash( b ) );
+    check( !json_equal( a, c ) && !json_equal( c, a ) );
+    check( json_hash( a ) != json_hash( c ) );
+    json_t const* inner = json_getProperty( a, "k" );
+    check( json_equal( inner, json_getProperty( b, "k" ) ) );
+    check( json_hash( inner ) == json_hash( json_getProperty( b, "k" ) ) );
+    check( json_serialize( b, out, sizeof out ) == len && !strcmp( out, doc ) );
+    check( json_serialize( inner, out, sizeof out ) == len - 6 && !strncmp( out, doc + 5, len - 6 ) );
+    size_t nodes, size;
+    check( json_cloneSize( b, &nodes, &size ) );
+    check( nodes == 1 + levels / 2 * 3 && size <= sizeof buf );
+    struct staticPool cpool = { { staticPoolInit, staticPoolAlloc }, mem[3], qty, 0 };
+    json_t const* copy = json_clone( b, &cpool.pool, buf, size );
+    check( copy && json_equal( copy, a ) );
+    check( json_hash( copy ) == json_hash( a ) );
+    done();
+}
+
+static int sorted( void ) {
+    json_t nodes[64];
+    struct staticPool spool = { { staticPoolInit, staticPoolAlloc }, nodes, 64, 0 };
+    {
+        char str[] = "{\"m\":1,\"c\":2,\"x\":{\"b\":true,\"a\":null},\"a\":3,\"k\":4,"
+                     "\"e\":5,\"z\":6,\"d\":7,\"m2\":8,\"a\":9}";
+        json_t const* json = json_createWithOptions( str, &spool.pool, NULL, JSON_SORT_KEYS );
+        check( json );
+        static char const* const names[] = { "m", "c", "x", "a", "k", "e", "z", "d", "m2", "a" };
+        json_t const* child = json_getChild( json );
+        unsigned int i;
+        for( i = 0; i < sizeof names / sizeof *names; ++i, child = json_getSibling( child ) ) {
+            check( child );
+            check( !strcmp( names[i], json_getName( child ) ) );
+        }
+        check( !child );
+        for( i = 0; i < sizeof names / sizeof *names; ++i ) {
+            json_t const* const property = json_getProperty( json, names[i] );
+            check( property );
+            check( !strcmp( names[i], json_getName( property ) ) );
+        }
+        check( !strcmp( "3", json_getPropertyValue( json, "a" ) ) );
+        check( !strcmp( "8", json_getPropertyValue( json, "m2" ) ) );
+        check( !json_getProperty( json, "" ) );
+        check( !json_getProperty( json, "b" ) );
+        check( !json_getProperty( json, "zz" ) );
+        json_t const* x = json_getProperty( json, "x" );
+        check( JSON_NULL == json_getType( json_getProperty( x, "a" ) ) );
+        check( JSON_BOOLEAN == json_getType( json_getProperty( x, "b" ) ) );
+        check( json_getPropertyLen( json, "m2x", 2 ) == json_getProperty( json, "m2" ) );
+        check( json_getPropertyLen( json, "m2", 1 ) == json_getProperty( json, "m" ) );
+        check( json_getPropertyLen( json, "ab", 1 ) == json_getProperty( json, "a" ) );
+        check( !json_getPropertyLen( json, "zz", 2 ) );
+        check( !json_getPropertyLen( json, "b", 0 ) );
+        check( json_getPropertyLen( x, "ba", 1 ) == json_getProperty( x, "b" ) );
+    }
+    {
+        char str[] = "{\"a\":1,\"b\":{\"c\":1,\"c\":2}}";
+        check( !json_createWithOptions( str, &spool.pool, NULL, JSON_UNIQUE_KEYS ) );
+    }
+    {
+        char str[] = "{\"a\":1,\"b\":{\"c\":1,\"d\":2}}";
+        check( json_createWithOptions( str, &spool.pool, NULL, JSON_UNIQUE_KEYS ) );
+    }
+    {
+        /* A large object in reverse order with each name three times. */
+        enum { names = 1000, qty = 3 * names, nodes = 2 * qty };
+        static char doc[ 16 * qty ];
+        static char str[ sizeof doc ];
+        static json_t mem[ nodes ];
+        size_t len = 0;
+        unsigned int i;
+        doc[ len++ ] = '{';
+        for( i = 0; i < qty; ++i )
+            len += (size_t)sprintf( doc + len, "%s\"k%u\":%u", i? ",": "", ( qty - 1 - i ) % names, i );
+        doc[ len++ ] = '}';
+        doc[ len ] = '\0';
+        struct staticPool big = { { staticPoolInit, staticPoolAlloc }, mem, nodes, 0 };
+        strcpy( str, doc );
+        json_t const* json = json_createWithOptions( str, &big.pool, NULL, JSON_SORT_KEYS );
+        check( json );
+        for( i = 0; i < names; ++i ) {
+            char name[16];
+            sprintf( name, "k%u", i );
+            json_t const* const property = json_getProperty( json, name );
+            check( property && json_getInteger( property ) == names - 1 - i );
+            check( json_getPropertyLen( json, name, strlen( name ) ) == property );
+        }
+        check( !json_getProperty( json, "k1000" ) );
+        check( !json_getProperty( json, "k" ) );
+        strcpy( str, doc );
+        check( !json_createWithOptions( str, &big.pool, NULL, JSON_UNIQUE_KEYS ) );
+        len = 0;
+        doc[ len++ ] = '{';
+        for( i = 0; i < qty; ++i )
+            len += (size_t)sprintf( doc + len, "%s\"k%u\":%u", i? ",": "", qty - 1 - i, i );
+        doc[ len++ ] = '}';
+        doc[ len ] = '\0';
+        strcpy( str, doc );
+        json = json_createWithOptions( str, &big.pool, NULL, JSON_UNIQUE_KEYS );
+        check( json );
+        check( json_getInteger( json_getProperty( json, "k0" ) ) == qty - 1 );
+        check( json_getInteger( json_getProperty( json, "k2999" ) ) == 0 );
+    }
+    done();
+}
+
+static int lookup( void ) {
+    char str[] = "{\"id\":1,\"name\":\"a\",\"price\":2.5,\"id\":3,\"tags\":[],\"a1m2z\":4,\"\":5}";
+    json_t mem[16];
+    json_t const* json = json_create( str, mem, 16 );
+    check( json );
+    {
+        static char const* const keys[] = { "price", "id", "missing", "tags", "" };
+        jsonLookup_t set;
+        check( json_initLookup( &set, keys, 5 ) );
+        check( set.seed );
+        json_t const* out[5];
+        check( 4 == json_getProperties( json, &set, out ) );
+        check( out[0] && !strcmp( "2.5", json_getValue( out[0] ) ) );
+        check( out[1] && !strcmp( "1", json_getValue( out[1] ) ) );
+        check( !out[2] );
+        check( out[3] && JSON_ARRAY == json_getType( out[3] ) );
+        check( out[4] && !strcmp( "5", json_getValue( out[4] ) ) );
+    }
+    {
+        static char const* const keys[] = { "a3m4z", "a1m2z", "name", "name" };
+        jsonLookup_t set;
+        check( json_initLookup( &set, keys, 4 ) );
+        check( !set.seed );
+        json_t const* out[4];
+        check( 3 == json_getProperties( json, &set, out ) );
+        check( !out[0] );
+        check( out[1] && !strcmp( "4", json_getValue( out[1] ) ) );
+        check( out[2] && out[2] == out[3] );
+    }
+    {
+        static char const* const keys[ JSON_MAXLOOKUP + 1 ] = { "id" };
+        jsonLookup_t set;
+        check( !json_initLookup( &set, keys, JSON_MAXLOOKUP + 1 ) );
+    }
+    done();
+}
+
+static int cursor( void ) {
+    char str[] = "{\"a\":1,\"b\":2,\"c\":3,\"d\":4}";
+    json_t mem[8];
+    json_t const* json = json_create( str, mem, 8 );
+    check( json );
+    jsonCursor_t cur;
+    json_initCursor( &cur, json );
+    static char const* const names[] = { "a", "b", "d", "c", "a", "d", "d", "b" };
+    unsigned int i;
+    for( i = 0; i < sizeof names / sizeof *names; ++i ) {
+        json_t const* property = json_getCursorProperty( &cur, names[i] );
+        check( property );
+        check( !strcmp( names[i], json_getName( property ) ) );
+    }
+    check( !json_getCursorProperty( &cur, "e" ) );
+    check( !strcmp( "3", json_getValue( json_getCursorProperty( &cur, "c" ) ) ) );
+    done();
+}
+
+static int steps( void ) {
+    static char const doc[] = "{\"a\":[1,2,{\"b\":\"some text\",\"c\":[]}],\"d\":{\"e\":null,\"f\":[true,false]},"
+                              "\"g\":-1.5e3,\"h\":[[[]]]}";
+    json_t mem[2][32];
+    char str[2][ sizeof doc ];
+    strcpy( str[0], doc );
+    struct staticPool whole = { { staticPoolInit, staticPoolAlloc }, mem[0], 32, 0 };
+    json_t const* json = json_createWithPool( str[0], &whole.pool );
+    check( json );
+    size_t budget;
+    for( budget = 1; budget < sizeof doc; budget *= 2 ) {
+        strcpy( str[1], doc );
+        struct staticPool spool = { { staticPoolInit, staticPoolAlloc }, mem[1], 32, 0 };
+        jsonStep_t step;
+        json_initStep( &step, str[1], &spool.pool, NULL, 0 );
+        unsigned int qty = 0;
+        jsonStepStatus_t status;
+        while( ( status = json_parseStep( &step, budget ) ) == JSON_STEP_MORE ) ++qty;
+        check( JSON_STEP_DONE == status );
+        check( JSON_STEP_DONE == json_parseStep( &step, budget ) );
+        check( budget > 1 || qty > 10 );
+        check( spool.next == whole.next );
+        check( !memcmp( str[0], str[1], sizeof doc ) );
+        check( json_equal( json, step.root ) );
+    }
+    {
+        char bad[] = "{\"a\":[1,2,3],\"b\":[1,nul]}";
+        struct staticPool spool = { { staticPoolInit, staticPoolAlloc }, mem[1], 32, 0 };
+        jsonStep_t step;
+        json_initStep( &step, bad, &spool.pool, NULL, 0 );
+        check( JSON_STEP_MORE == json_parseStep( &step, 1 ) );
+        jsonStepStatus_t status;
+        while( ( status = json_parseStep( &step, 1 ) ) == JSON_STEP_MORE );
+        check( JSON_STEP_ERROR == status );
+        check( JSON_STEP_ERROR == json_parseStep( &step, 1 ) );
+    }
+    done();
+}
+
+static int deferred( void ) {
+    static char const doc[] = "{\"plain\":\"some text without escapes to skip fast\","
+                              "\"html\":\"<a href=\\\"x\\\">\\u0041 \\\\ \\/<\\/a>\\n\","
+                              "\"n\\u0061me\":\"\\t\",\"list\":[\"a\\\"b\",\"\"]}";
+    json_t mem[2][16];
+    char str[2][ sizeof doc ];
+    strcpy( str[0], doc );
+    strcpy( str[1], doc );
+    struct staticPool spool = { { staticPoolInit, staticPoolAlloc }, mem[1], 16, 0 };
+    json_t const* eager = json_create( str[0], mem[0], 16 );
+    json_t const* lazy = json_createWithOptions( str[1], &spool.pool, NULL, JSON_DEFER_ESCAPES );
+    check( eager && lazy );
+    json_t const* plain = json_getProperty( lazy, "plain" );
+    check( !json_hasEscapes( plain ) );
+    check( json_getText( plain ) == json_getValue( plain ) );
+    json_t const* html = json_getProperty( lazy, "html" );
+    check( json_hasEscapes( html ) );
+    check( !strcmp( "<a href=\\\"x\\\">\\u0041 \\\\ \\/<\\/a>\\n", json_getValue( html ) ) );
+    check( !strcmp( "<a href=\"x\">A \\ /</a>\n", json_getText( html ) ) );
+    check( !json_hasEscapes( html ) );
+    check( !strcmp( json_getText( html ), json_getValue( html ) ) );
+    check( json_getProperty( lazy, "name" ) );
+    check( json_equal( eager, lazy ) );
+    check( json_hash( eager ) == json_hash( lazy ) );
+    static char const* const bad[] = { "{\"a\":\"\\x\"}", "{\"a\":\"\\u12G4\"}", "{\"a\":\"abc" };
+    unsigned int i;
+    for( i = 0; i < sizeof bad / sizeof *bad; ++i ) {
+        strcpy( str[1], bad[i] );
+        check( !json_createWithOptions( str[1], &spool.pool, NULL, JSON_DEFER_ESCAPES ) );
+    }
+    done();
+}
+
+static int bounded( void ) {
+    static char const* const good[] = {
+        "{\"a\":[1,2,{\"b\":\"x\\\"]\"}],\"c\":true}", "[1,2]", "[true]", "  [ -1.5e3 ]\n\t ",
+        "{\"some long name\":\"a text that is long enough to be scanned eight by eight\"}"
+    };
+    static char const* const bad[] = {
+        "{\"a\":\"x]", "{\"a\":1", "[1,2", "", "   ", "[\"abc\\]", "{\"a\":tru}", "[\"\\u12]"
+    };
+    json_t mem[16];
+    struct staticPool spool = { { staticPoolInit, staticPoolAlloc }, mem, 16, 0 };
+    unsigned int i;
+    for( i = 0; i < sizeof good / sizeof *good; ++i ) {
+        size_t const len = strlen( good[i] );
+        char* const str = malloc( len );
+        check( str );
+        memcpy( str, good[i], len );
+        json_t const* json = json_createN( str, len, &spool.pool );
+        char copy[128];
+        strcpy( copy, good[i] );
+        json_t mem2[16];
+        json_t const* expected = json_create( copy, mem2, 16 );
+        check( json && expected );
+        check( json_equal( json, expected ) );
+        free( str );
+    }
+    for( i = 0; i < sizeof bad / sizeof *bad; ++i ) {
+        size_t const len = strlen( bad[i] );
+        char* const str = malloc( len + 1 );
+        check( str );
+        memcpy( str, bad[i], len );
+        check( !json_createN( str, len, &spool.pool ) );
+        free( str );
+    }
+    {
+        char str[] = "{\"a\":\"x\0y\"}";
+        check( !json_createN( str, sizeof str - 1, &spool.pool ) );
+    }
+    done();
+}
+
+static int clone( void ) {
+    static char const doc[] = "{\"id\":7,\"name\":\"a \\\"b\\\"\",\"ok\":true,\"none\":null,"
+                              "\"v\":[1,2,3],\"w\":[1.5,2],\"z\":{\"y\":{},\"x\":[[],{\"k\":-1e3}]}}";
+    json_t mem[3][32];
+    char str[2][ sizeof doc ];
+    strcpy( str[0], doc );
+    strcpy( str[1], doc );
+    json_t const* expected = json_create( str[0], mem[0], 32 );
+    struct staticPool spool = { { staticPoolInit, staticPoolAlloc }, mem[1], 32, 0 };
+    unsigned int const options = JSON_PACK_NUMBERS | JSON_SORT_KEYS | JSON_DEFER_ESCAPES;
+    json_t const* json = json_createWithOptions( str[1], &spool.pool, NULL, options );
+    check( expected && json );
+    size_t qty, size;
+    check( json_cloneSize( json, &qty, &size ) );
+    check( 13 == qty );
+    char buf[512];
+    check( size <= sizeof buf );
+    struct staticPool cpool = { { staticPoolInit, staticPoolAlloc }, mem[2], qty, 0 };
+    check( !json_clone( json, &cpool.pool, buf, 16 ) );
+    cpool.qty = qty - 1;
+    check( !json_clone( json, &cpool.pool, buf, size ) );
+    cpool.qty = qty;
+    json_t const* copy = json_clone( json, &cpool.pool, buf, size );
+    check( copy );
+    memset( str[1], 'x', sizeof str[1] );
+    memset( mem[1], 0, sizeof mem[1] );
+    check( json_equal( copy, expected ) );
+    check( json_hash( copy ) == json_hash( expected ) );
+    check( json_getText( json_getProperty( copy, "name" ) ) >= buf );
+    check( !strcmp( "a \"b\"", json_getText( json_getProperty( copy, "name" ) ) ) );
+    check( 3 == json_getArrayLength( json_getProperty( copy, "v" ) ) );
+    json_t const* z = json_getProperty( copy, "z" );
+    check( z && json_getProperty( z, "x" ) == json_getChild( z )->sibling );
+    check( json_getProperty( json_getChild( json_getProperty( z, "x" ) )->sibling, "k" ) );
+    {
+        json_t const* name = json_getProperty( expected, "name" );
+        json_t const* leaf = json_clone( name, &cpool.pool, buf, sizeof buf );
+        check( leaf && cpool.next == 1 );
+        check( !strcmp( "name", json_getName( leaf ) ) );
+        check( !strcmp( "a \"b\"", json_getValue( leaf ) ) );
+    }
+    done();
+}
+
+static int indexed( void ) {
+    char str[] = "[{\"id\":3,\"name\":\"c\"},{\"id\":\"x\\/1\",\"name\":\"t\"},{\"name\":\"none\"},"
+                 "{\"id\":-12,\"name\":\"n\"},7,{\"id\":3,\"name\":\"dup\"},{\"id\":2.0,\"name\":\"r\"},"
+                 "{\"id\":[1],\"name\":\"a\"}]";
+    json_t mem[64];
+    struct staticPool spool = { { staticPoolInit, staticPoolAlloc }, mem, 64, 0 };
+    json_t const* json = json_createWithOptions( str, &spool.pool, NULL, JSON_DEFER_ESCAPES );
+    check( json );
+    jsonIndex_t index;
+    check( !json_indexArrayBy( &index, json_getChild( json ), "id", &spool.pool ) );
+    check( json_indexArrayBy( &index, json, "id", &spool.pool ) );
+    check( 4 == index.qty );
+    check( !strcmp( "c", json_getPropertyValue( json_getIndexedInteger( &index, 3 ), "name" ) ) );
+    check( !strcmp( "n", json_getPropertyValue( json_getIndexedInteger( &index, -12 ), "name" ) ) );
+    check( !strcmp( "r", json_getPropertyValue( json_getIndexedInteger( &index, 2 ), "name" ) ) );
+    check( !strcmp( "t", json_getPropertyValue( json_getIndexedText( &index, "x/1" ), "name" ) ) );
+    check( !json_getIndexedText( &index, "3" ) );
+    check( !json_getIndexedInteger( &index, 7 ) );
+    check( !json_getIndexedInteger( &index, INT64_MIN ) );
+    char other[] = "{\"ref\":3.0}";
+    json_t mem2[4];
+    json_t const* ref = json_getProperty( json_create( other, mem2, 4 ), "ref" );
+    check( json_getIndexed( &index, ref ) == json_getChild( json ) );
+    spool.qty = spool.next;
+    check( !json_indexArrayBy( &index, json, "id", &spool.pool ) );
+    check( !json_getIndexedInteger( &index, 3 ) );
+    done();
+}
+
+static int edit( void ) {
+    char str[] = "{\"name\":\"a\\\"b\",\"port\":8080,\"rate\":1.50e1,\"tags\":[\"x\",\"y\"],"
+                 "\"v\":[1,2.5],\"opts\":{\"debug\":false,\"old\":null}}";
+    json_t mem[32];
+    struct staticPool spool = { { staticPoolInit, staticPoolAlloc }, mem, 32, 0 };
+    unsigned int const options = JSON_PACK_NUMBERS | JSON_SORT_KEYS | JSON_DEFER_ESCAPES;
+    json_t const* json = json_createWithOptions( str, &spool.pool, NULL, options );
+    check( json );
+    char out[256];
+    size_t len = json_serialize( json, out, sizeof out );
+    check( len == strlen( out ) );
+    check( !strcmp( "{\"name\":\"a\\\"b\",\"port\":8080,\"rate\":1.50e1,\"tags\":[\"x\",\"y\"],"
+                    "\"v\":[1.0,2.5],\"opts\":{\"debug\":false,\"old\":null}}", out ) );
+    char buf[64];
+    jsonEdit_t edit;
+    json_initEdit( &edit, &spool.pool, buf, sizeof buf );
+    json_t const* opts = json_getProperty( json, "opts" );
+    json_t const* tags = json_getProperty( json, "tags" );
+    check( json_setInteger( &edit, json_getProperty( json, "port" ), -443 ) );
+    check( json_setReal( &edit, json_getProperty( json, "rate" ), 2 ) );
+    check( !json_setReal( &edit, json_getProperty( json, "rate" ), 1e308 * 10 ) );
+    json_setBoolean( json_getProperty( opts, "debug" ), true );
+    check( json_remove( opts, json_getProperty( opts, "old" ) ) );
+    check( !json_remove( opts, tags ) );
+    check( json_rename( &edit, json, json_getProperty( json, "name" ), "title" ) );
+    check( json_getProperty( json, "title" ) && !json_getProperty( json, "name" ) );
+    check( !json_rename( &edit, opts, json_getProperty( json, "port" ), "x" ) );
+    check( !json_rename( &edit, json, json_getProperty( opts, "debug" ), "x" ) );
+    check( !json_rename( &edit, tags, json_getChild( tags ), "x" ) );
+    check( !json_rename( &edit, json, json, "x" ) );
+    check( json_getProperty( json, "port" ) && json_getProperty( opts, "debug" ) );
+    check( !json_getName( json_getChild( tags ) ) );
+    json_t const* level = json_insert( &edit, opts, NULL, "level" );
+    check( level && json_setText( &edit, level, "a\tb\x01" ) );
+    check( json_setText( &edit, json_insert( &edit, tags, json_getChild( tags ), NULL ), "w" ) );
+    check( json_setEmpty( json_insert( &edit, tags, NULL, NULL ), JSON_OBJ ) );
+    check( !json_insert( &edit, tags, NULL, "named" ) );
+    check( !json_insert( &edit, json_getProperty( json, "v" ), NULL, NULL ) );
+    check( !json_insert( &edit, tags, opts, NULL ) );
+    len = json_serialize( json, out, sizeof out );
+    check( len == strlen( out ) );
+    check( !strcmp( "{\"title\":\"a\\\"b\",\"port\":-443,\"rate\":2.0,\"tags\":[\"w\",\"x\",\"y\",{}],"
+                    "\"v\":[1.0,2.5],\"opts\":{\"debug\":true,\"level\":\"a\\tb\\u0001\"}}", out ) );
+    check( len == json_serialize( json, out, 10 ) );
+    check( !strcmp( "{\"title\":", out ) );
+    json_t mem2[32];
+    json_t const* reparsed = json_create( out, mem2, 32 );
+    check( !reparsed );
+    json_serialize( json, out, sizeof out );
+    reparsed = json_create( out, mem2, 32 );
+    check( reparsed && json_equal( json, reparsed ) );
+    {
+        /* The reals that overflowed have no JSON spelling. */
+        char big[] = "[1e400,2.5,-1e999]";
+        json_t const* const array = json_createWithOptions( big, &spool.pool, NULL, JSON_PACK_NUMBERS );
+        check( array );
+        check( 0 == json_serialize( array, out, sizeof out ) && !out[0] );
+    }
+    done();
+}
+
+static int unicode( void ) {
+    static struct { char const* json; char const* text; } const good[] = {
+        { "[\"\\u0041\\u00e8\\u20AC\\ud83d\\ude00\"]", "A\xC3\xA8\xE2\x82\xAC\xF0\x9F\x98\x80" },
+        { "[\"plain \xC3\xA8 text \xE2\x82\xAC and more text \xF0\x9F\x98\x80 \xF4\x8F\xBF\xBF.\"]",
+          "plain \xC3\xA8 text \xE2\x82\xAC and more text \xF0\x9F\x98\x80 \xF4\x8F\xBF\xBF." },
+        { "[\"\\u007f\\u0080\\u07FF\\u0800\\uFFFF\"]", "\x7F\xC2\x80\xDF\xBF\xE0\xA0\x80\xEF\xBF\xBF" },
+    };
+    static char const* const bad[] = {
+        "[\"\\ud83d\"]", "[\"\\ude00\\ud83d\"]", "[\"\\ud83d\\u0041\"]", "[\"\\u0000\"]",
+        "[\"\xC0\x80\"]", "[\"\xE0\x80\x80\"]", "[\"\xED\xA0\x80\"]", "[\"\xF4\x90\x80\x80\"]",
+        "[\"a long text before it \x80\"]", "[\"\xC3\"]", "[\"\xE2\x82\"]", "[\"\xF8\x88\x80\x80\x80\"]",
+        "{\"\xFF\":1}"
+    };
+    json_t mem[4];
+    char str[96];
+    unsigned int i, j;
+    for( i = 0; i < sizeof good / sizeof *good; ++i ) {
+        for( j = 0; j < 3; ++j ) {
+            strcpy( str, good[i].json );
+            struct staticPool spool = { { staticPoolInit, staticPoolAlloc }, mem, 4, 0 };
+            json_t const* json = j == 0? json_create( str, mem, 4 ):
+                                 j == 1? json_createWithOptions( str, &spool.pool, NULL, JSON_DEFER_ESCAPES ):
+                                         json_createN( str, strlen( str ), &spool.pool );
+            check( json );
+            check( !strcmp( good[i].text, json_getText( json_getChild( json ) ) ) );
+        }
+        check( json_validate( good[i].json, strlen( good[i].json ) ) );
+    }
+    for( i = 0; i < sizeof bad / sizeof *bad; ++i ) {
+        for( j = 0; j < 3; ++j ) {
+            strcpy( str, bad[i] );
+            struct staticPool spool = { { staticPoolInit, staticPoolAlloc }, mem, 4, 0 };
+            json_t const* json = j == 0? json_create( str, mem, 4 ):
+                                 j == 1? json_createWithOptions( str, &spool.pool, NULL, JSON_DEFER_ESCAPES ):
+                                         json_createN( str, strlen( str ), &spool.pool );
+            check( !json );
+        }
+        check( !json_validate( bad[i], strlen( bad[i] ) ) );
+    }
+    done();
+}
+
+static int scan( void ) {
+    char str[] = " { \"n\\u0061me\" : \"x\\ty\", \"id\": -42, \"r\": 2, \"ok\": true,"
+                 " \"more\": [1,{\"a\":null}], \"no\": false, \"s\": \"v\" } ";
+    json_t mem[8];
+    struct staticPool spool = { { staticPoolInit, staticPoolAlloc }, mem, 8, 0 };
+    jsonParser_t parser;
+    json_initScan( &parser, str, &spool.pool );
+    char* ptr = json_scanBlank( str );
+    check( ptr && *ptr == '{' );
+    ptr = json_scanBlank( ptr + 1 );
+    size_t len;
+    char const* name = ptr + 1;
+    ptr = json_scanName( ptr, &parser, &len );
+    check( ptr && 4 == len && !strcmp( "name", name ) );
+    char const* text;
+    check( !json_scanInteger( ptr, &parser, &(int64_t){ 0 } ) );
+    ptr = json_scanText( ptr, &parser, &text );
+    check( ptr && !strcmp( "x\ty", text ) );
+    ptr = json_scanName( json_scanBlank( json_scanBlank( ptr ) + 1 ), &parser, &len );
+    int64_t integer;
+    ptr = json_scanInteger( ptr, &parser, &integer );
+    check( ptr && -42 == integer );
+    ptr = json_scanName( json_scanBlank( json_scanBlank( ptr ) + 1 ), &parser, &len );
+    double real;
+    check( !json_scanText( ptr, &parser, &text ) );
+    ptr = json_scanReal( ptr, &parser, &real );
+    check( ptr && 2.0 == real );
+    ptr = json_scanName( json_scanBlank( json_scanBlank( ptr ) + 1 ), &parser, &len );
+    bool boolean;
+    ptr = json_scanBoolean( ptr, &boolean );
+    check( ptr && boolean );
+    ptr = json_scanName( json_scanBlank( json_scanBlank( ptr ) + 1 ), &parser, &len );
+    json_t const* value;
+    ptr = json_scanValue( ptr, &parser, &value );
+    check( ptr && JSON_ARRAY == json_getType( value ) );
+    check( JSON_NULL == json_getType( json_getProperty( json_getSibling( json_getChild( value ) ), "a" ) ) );
+    ptr = json_scanName( json_scanBlank( json_scanBlank( ptr ) + 1 ), &parser, &len );
+    ptr = json_scanValue( ptr, &parser, &value );
+    check( ptr && JSON_BOOLEAN == json_getType( value ) && !json_getBoolean( value ) );
+    ptr = json_scanName( json_scanBlank( json_scanBlank( ptr ) + 1 ), &parser, &len );
+    check( !json_scanBoolean( ptr, &boolean ) );
+    ptr = json_scanText( ptr, &parser, &text );
+    check( ptr && !strcmp( "v", text ) );
+    ptr = json_scanBlank( ptr );
+    check( ptr && *ptr == '}' );
+    check( !json_scanBlank( ptr + 1 ) );
+    done();
+}
+
+static int generated( void ) {
+    json_t mem[8];
+    struct staticPool spool = { { staticPoolInit, staticPoolAlloc }, mem, 8, 0 };
+    order_t order;
+    {
+        char str[] = "{\"id\":7,\"symbol\":\"ABC\",\"price\":2.5,\"qty\":-3,\"active\":true,"
+                     "\"extra\":[1,{}],\"instrument\":{\"lot\":100,\"tick\":1}}";
+        check( order_parse( str, &order, &spool.pool ) );
+        check( 7 == order.id && !strcmp( "ABC", order.symbol ) && 2.5 == order.price && -3 == order.qty );
+        check( order.active && 100 == order.instrument.lot && 1.0 == order.instrument.tick );
+        check( !order.account && !order.instrument.isin );
+    }
+    /* A field of another type is parsed as an unknown property and left zero. */
+    static char const* const mismatched[] = {
+        "{\"id\":\"1\",\"qty\":2}", "{\"id\":1.5,\"qty\":2}", "{\"id\":-1e3,\"qty\":2}", "{\"active\":1,\"qty\":2}",
+        "{\"price\":\"x\",\"qty\":2}", "{\"price\":false,\"qty\":2}", "{\"symbol\":3,\"qty\":2}",
+        "{\"instrument\":[1],\"qty\":2}", "{\"id\":null,\"qty\":2}"
+    };
+    unsigned int i;
+    for( i = 0; i < sizeof mismatched / sizeof *mismatched; ++i ) {
+        char str[32];
+        strcpy( str, mismatched[i] );
+        check( order_parse( str, &order, &spool.pool ) );
+        check( 2 == order.qty );
+        check( 0 == order.id && 0 == order.price && !order.active && !order.symbol && !order.instrument.lot );
+    }
+    static char const* const bad[] = { "{\"id\":1x,\"qty\":2}", "{\"active\":tru}", "{\"price\":-}", "[]" };
+    for( i = 0; i < sizeof bad / sizeof *bad; ++i ) {
+        char str[32];
+        strcpy( str, bad[i] );
+        check( !order_parse( str, &order, &spool.pool ) );
+    }
+    done();
+}
+
+static int large( void ) {
+    {
+        char str[] = "{\"a\":[1,2],\"b\":null}";
+        json_t mem[5];
+        check( !json_create( str, mem, 4 ) );
+    }
+#if SIZE_MAX > UINT_MAX
+    {
+        /* The number of json properties is not truncated to 32 bits.
+           Only the properties that are used are touched. */
+        char str[] = "{\"a\":[1,2],\"b\":null}";
+        json_t mem[5];
+        json_t const* json = json_create( str, mem, (size_t)UINT_MAX + 2 );
+        check( json );
+        check( 2 == json_getInteger( json_getSibling( json_getChild( json_getProperty( json, "a" ) ) ) ) );
+    }
+#endif
+    done();
+}
+
+static int decoders( void ) {
+    char str[] = "{\"hex\":\"00ff10AbCdEf9876543210\",\"short\":\"7f\",\"odd\":\"abc\",\"badhex\":\"00112233445566zz\","
+                 "\"b64\":\"SGVsbG8sIHdvcmxkIQ==\",\"raw\":\"SGVsbG8\",\"slash\":\"\\/+8=\",\"bad64\":\"SGVs*G8sIHdvcmxk\","
+                 "\"len\":\"a\\u00e9\\n\",\"t0\":\"1970-01-01T00:00:00Z\",\"t1\":\"2024-02-29t23:59:59.123456789123+01:30\","
+                 "\"t2\":\"1969-12-31 23:59:59.5z\",\"t3\":\"2023-02-29T00:00:00Z\",\"t4\":\"2024-01-01T00:00:00\","
+                 "\"t5\":\"2024-01-01T00:00:00.Z\",\"t6\":\"2300-01-01T00:00:00Z\",\"t7\":\"2024-01-01T24:00:00Z\","
+                 "\"t8\":\"2024-01-01T00:00:00.5\",\"t9\":\"2024-01-01T00:00:00ZZ\",\"t10\":\"2024-01-01T00:00:00+01:00Z\"}";
+    json_t mem[32];
+    json_t const* json = json_create( str, mem, sizeof mem / sizeof *mem );
+    check( json );
+    size_t size;
+
+    unsigned char const hex[] = { 0x00, 0xFF, 0x10, 0xAB, 0xCD, 0xEF, 0x98, 0x76, 0x54, 0x32, 0x10 };
+    json_t const* property = json_getProperty( json, "hex" );
+    check( 22 == json_getTextLength( property ) );
+    unsigned char const* bytes = json_decodeHex( property, &size );
+    check( bytes && sizeof hex == size && !memcmp( hex, bytes, size ) );
+    bytes = json_decodeHex( json_getProperty( json, "short" ), &size );
+    check( bytes && 1 == size && 0x7F == bytes[0] );
+    check( !json_decodeHex( json_getProperty( json, "odd" ), &size ) );
+    check( !json_decodeHex( json_getProperty( json, "badhex" ), &size ) );
+
+    bytes = json_decodeBase64( json_getProperty( json, "b64" ), &size );
+    check( bytes && 13 == size && !memcmp( "Hello, world!", bytes, size ) );
+    bytes = json_decodeBase64( json_getProperty( json, "raw" ), &size );
+    check( bytes && 5 == size && !memcmp( "Hello", bytes, size ) );
+    bytes = json_decodeBase64( json_getProperty( json, "slash" ), &size );
+    check( bytes && 2 == size && 0xFF == bytes[0] && 0xEF == bytes[1] );
+    check( !json_decodeBase64( json_getProperty( json, "bad64" ), &size ) );
+
+    check( 4 == json_getTextLength( json_getProperty( json, "len" ) ) );
+
+    int64_t ns;
+    check( json_getTimestamp( json_getProperty( json, "t0" ), &ns ) && 0 == ns );
+    check( json_getTimestamp( json_getProperty( json, "t1" ), &ns ) );
+    check( ( INT64_C(1709251199) - 5400 ) * 1000000000 + 123456789 == ns );
+    check( json_getTimestamp( json_getProperty( json, "t2" ), &ns ) && -500000000 == ns );
+    check( !json_getTimestamp( json_getProperty( json, "t3" ), &ns ) );
+    check( !json_getTimestamp( json_getProperty( json, "t4" ), &ns ) );
+    check( !json_getTimestamp( json_getProperty( json, "t5" ), &ns ) );
+    check( !json_getTimestamp( json_getProperty( json, "t6" ), &ns ) );
+    check( !json_getTimestamp( json_getProperty( json, "t7" ), &ns ) );
+    check( !json_getTimestamp( json_getProperty( json, "t8" ), &ns ) );
+    check( !json_getTimestamp( json_getProperty( json, "t9" ), &ns ) );
+    check( !json_getTimestamp( json_getProperty( json, "t10" ), &ns ) );
+    done();
+}
+
+/** Parse a top-level array in parts one after the other, as threads would. */
+static json_t const* parseParts( char* str, unsigned int qty, struct staticPool pools[] ) {
+    static jsonSplit_t split;
+    qty = json_splitArray( &split, str, strlen( str ), qty, 0 );
+    if ( !qty ) return NULL;
+    unsigned int i;
+    for( i = 0; i < qty; ++i )
+        json_scanPart( &split, i );
+    if ( !json_findElements( &split ) ) return NULL;
+    for( i = 0; i < qty; ++i )
+        if ( !json_parsePart( &split, i, &pools[i].pool ) ) return NULL;
+    return json_joinParts( &split );
+}
+
+static int parallel( void ) {
+    static char const doc[] =
+        " [ {\"id\":1,\"text\":\"a, [b] {c}\"}, \"\\\"],[\\\\\", 12.5 ,[1,[2,[3]]],"
+        "{\"q\":\"\\\\\\\\\\\"\",\"e\":{}} , null,true,false, -7,\"\\u00e9\\n\", [] ,{\"x\":[\"]\",\"[\"]} ]\n";
+    enum { parts = 24, nodes = 32 };
+    static json_t mem[ parts ][ nodes ];
+    struct staticPool pools[ parts ];
+    unsigned int i;
+    for( i = 0; i < parts; ++i ) {
+        struct staticPool const pool = { { staticPoolInit, staticPoolAlloc }, mem[i], nodes, 0 };
+        pools[i] = pool;
+    }
+    char expected[ sizeof doc ];
+    memcpy( expected, doc, sizeof doc );
+    json_t ref[ nodes ];
+    json_t const* const reference = json_create( expected, ref, nodes );
+    check( reference );
+    unsigned int qty;
+    for( qty = 1; qty <= parts; ++qty ) {
+        char str[ sizeof doc ];
+        memcpy( str, doc, sizeof doc );
+        json_t const* const json = parseParts( str, qty, pools );
+        check( json && JSON_ARRAY == json_getType( json ) );
+        check( json_equal( json, reference ) );
+    }
+    {
+        char str[] = "[]";
+        json_t const* const json = parseParts( str, 2, pools );
+        check( json && !json_getChild( json ) );
+    }
+    static char const* const bad[] = {
+        "{\"a\":1}", "[1,2", "[1,2]]", "[1,\"2]", "[1,2] [3,4]", "[1,2],3", "[1,x]", "[1,{\"a\"}]"
+    };
+    for( i = 0; i < sizeof bad / sizeof *bad; ++i ) {
+        for( qty = 1; qty <= 4; ++qty ) {
+            char str[16];
+            strcpy( str, bad[i] );
+            check( !parseParts( str, qty, pools ) );
+        }
+    }
+    done();
+}
+
+static bool matches( char const* record, char const* path, jsonCondition_t condition, char const* text ) {
+    jsonPredicate_t pred;
+    if ( !json_initTextPredicate( &pred, path, condition, text ) ) return false;
+    return json_matchRecord( record, strlen( record ), &pred, 1 );
+}
+
+static bool inRange( char const* record, char const* path, double min, double max ) {
+    jsonPredicate_t pred;
+    if ( !json_initRangePredicate( &pred, path, min, max ) ) return false;
+    return json_matchRecord( record, strlen( record ), &pred, 1 );
+}
+
+static int predicates( void ) {
+    static char const r1[] = "{\"ts\":\"2024-01-01\", \"level\" : \"error\",\"msg\":\"disk \\\"level\\\":\\\"error\\\"\","
+                             "\"meta\":{\"host\":\"web-1\",\"load\":0.75}}";
+    check( matches( r1, "level", JSON_EQUAL, "error" ) );
+    check( !matches( r1, "level", JSON_EQUAL, "err" ) );
+    check( !matches( r1, "level", JSON_EQUAL, "errors" ) );
+    check( matches( r1, "level", JSON_PREFIX, "err" ) );
+    check( matches( r1, "level", JSON_PREFIX, "" ) );
+    check( !matches( r1, "level", JSON_PREFIX, "info" ) );
+    check( matches( r1, "meta.host", JSON_PREFIX, "web-" ) );
+    check( !matches( r1, "host", JSON_PREFIX, "web-" ) );
+    check( !matches( r1, "source", JSON_EQUAL, "error" ) );
+    check( inRange( r1, "meta.load", 0.5, 1 ) );
+    check( !inRange( r1, "meta.load", 0, 0.5 ) );
+    check( !inRange( r1, "level", 0, 1 ) );
+    check( !matches( r1, "meta.load", JSON_EQUAL, "0.75" ) );
+
+    jsonPredicate_t preds[2];
+    check( json_initTextPredicate( &preds[0], "level", JSON_EQUAL, "error" ) );
+    check( json_initRangePredicate( &preds[1], "meta.load", 0.5, 1 ) );
+    check( json_matchRecord( r1, sizeof r1 - 1, preds, 2 ) );
+    check( json_initRangePredicate( &preds[1], "meta.load", 1, 2 ) );
+    check( !json_matchRecord( r1, sizeof r1 - 1, preds, 2 ) );
+    check( json_matchRecord( r1, sizeof r1 - 1, preds, 0 ) );
+
+    /* The names in strings, in nested values or used as values do not count. */
+    check( !matches( "{\"msg\":\"\\\"level\\\":\\\"error\\\"\",\"level\":\"info\"}", "level", JSON_EQUAL, "error" ) );
+    check( matches( "{\"msg\":\"\\\"level\\\":\\\"error\\\"\",\"level\":\"info\"}", "level", JSON_EQUAL, "info" ) );
+    check( !matches( "{\"data\":{\"level\":\"error\"},\"level\":\"warn\"}", "level", JSON_EQUAL, "error" ) );
+    check( matches( "{\"data\":{\"level\":\"error\"},\"level\":\"warn\"}", "level", JSON_EQUAL, "warn" ) );
+    check( matches( "{\"tag\":\"level\",\"level\":\"debug\"}", "level", JSON_EQUAL, "debug" ) );
+    check( matches( "{\"x\":\"}}}}}}}}}}}}]]]\",\"y\":[[[[1]]]],\"z\":{},\"level\":\"ok\"}", "level", JSON_EQUAL, "ok" ) );
+    check( matches( "{\"x\":\"\\\\\",\"level\":\"ok\"}", "level", JSON_EQUAL, "ok" ) );
+    check( !matches( "{\"level\\\"\":1,\"x\":\"level\"}", "level", JSON_EQUAL, "x" ) );
+
+    /* A name of a nested object is not searched beyond it. */
+    static char const r2[] = "{\"a\":{\"x\":[1,{\"b\":2}],\"y\":\"--------\"},\"c\":{\"b\":3}}";
+    check( !inRange( r2, "a.b", 0, 10 ) );
+    check( inRange( r2, "c.b", 3, 3 ) );
+    check( !inRange( r2, "a.x.b", 0, 10 ) );
+
+    /* Escape sequences are decoded in the values. */
+    static char const r3[] = "{\"name\":\"caf\\u00e9 \\\"x\\\"\",\"level\":\"error\"}";
+    check( matches( r3, "name", JSON_EQUAL, "caf\xC3\xA9 \"x\"" ) );
+    check( matches( r3, "name", JSON_PREFIX, "caf\xC3" ) );
+    check( !matches( r3, "name", JSON_EQUAL, "cafe \"x\"" ) );
+    check( !matches( "{\"name\":\"a\\q\"}", "name", JSON_PREFIX, "ab" ) );
+
+    check( inRange( "{\"v\":-1.5e2}", "v", -200, -100 ) );
+    check( !inRange( "{\"v\":\"12\"}", "v", 0, 100 ) );
+    check( !inRange( "{\"v\":true}", "v", 0, 100 ) );
+    /* The values follow the grammar of the JSON numbers. */
+    check( !inRange( "{\"v\":01}", "v", 0, 100 ) );
+    check( !inRange( "{\"v\":1.}", "v", 0, 100 ) );
+    check( !inRange( "{\"v\":.5}", "v", 0, 100 ) );
+    check( !inRange( "{\"v\":+1}", "v", 0, 100 ) );
+    check( !inRange( "{\"v\":1e}", "v", 0, 100 ) );
+    check( !inRange( "{\"v\":1-2}", "v", -100, 100 ) );
+    check( inRange( "{\"v\":0.5,\"w\":1}", "v", 0.25, 0.75 ) );
+    check( inRange( "{\"v\":0.12345678901234567890123}", "v", 0.1234567890123456, 0.1234567890123457 ) );
+    check( inRange( "{\"v\":12345678901234567890.5e-19}", "v", 1.2345678901234567, 1.2345678901234568 ) );
+    check( inRange( "{\"v\":0.000000000000000000000000000001}", "v", 0.9e-30, 1.1e-30 ) );
+    check( !matches( "[{\"level\":\"error\"}]", "level", JSON_EQUAL, "error" ) );
+    check( !matches( "", "level", JSON_EQUAL, "error" ) );
+
+    /* The records of NDJSON are not null-terminated. */
+    static char const lines[] = "{\"level\":\"info\"}\n{\"level\":\"error\"}\n";
+    size_t const first = (size_t)( strchr( lines, '\n' ) - lines );
+    check( !json_matchRecord( lines, first, preds, 1 ) );
+    check( json_matchRecord( lines + first + 1, sizeof lines - first - 2, preds, 1 ) );
+    check( !json_matchRecord( "{\"level\":\"error\"}", 12, preds, 1 ) );
+
+    jsonPredicate_t pred;
+    check( !json_initTextPredicate( &pred, "", JSON_EQUAL, "x" ) );
+    check( !json_initTextPredicate( &pred, "a..b", JSON_EQUAL, "x" ) );
+    check( !json_initRangePredicate( &pred, "a.b.c.d.e", 0, 1 ) );
+    check( json_initRangePredicate( &pred, "a.b.c.d", 0, 1 ) && pred.depth == 4 );
+
+    /* The record is not modified, so it can be parsed after it. */
+    char str[ sizeof r1 ];
+    memcpy( str, r1, sizeof r1 );
+    check( json_matchRecord( str, sizeof str - 1, preds, 1 ) && !memcmp( str, r1, sizeof r1 ) );
+    json_t mem[16];
+    json_t const* const json = json_create( str, mem, sizeof mem / sizeof *mem );
+    check( json && !strcmp( json_getPropertyValue( json, "level" ), "error" ) );
+    done();
+}
 
 // --------------------------------------------------------- Execute tests: ---
 
@@ -374,6 +1556,33 @@ int main( void ) {
         { array,       "Array"                  },
         { badformat,   "Bad format"             },
         { goodformats, "Formats"                },
+        { keys,        "Interned names"         },
+        { numbers,     "Numbers"                },
+        { consecutive, "Consecutive documents"  },
+        { packed,      "Packed arrays"          },
+        { columns,     "Columns"                },
+        { validate,    "Validation"             },
+        { minify,      "Minify"                 },
+        { equality,    "Equality"               },
+        { deep,        "Deep nesting"           },
+        { sorted,      "Sorted keys"            },
+        { lookup,      "Multi-key lookup"       },
+        { cursor,      "Lookup cursor"          },
+        { steps,       "Parse in steps"         },
+        { shared,      "Shared pool"            },
+        { deferred,    "Deferred escapes"       },
+        { bounded,     "Length-bounded parse"   },
+        { clone,       "Clone"                  },
+        { indexed,     "Keyed index"            },
+        { edit,        "Edit and serialize"     },
+        { unicode,     "Unicode"                },
+        { scan,        "Scan functions"         },
+        { generated,   "Generated parsers"      },
+        { large,       "Large documents"        },
+        { decoders,    "Typed decoders"         },
+        { parallel,    "Parallel parse"         },
+        { threads,     "Threaded parse"         },
+        { predicates,  "Raw predicates"         },
     };
     return test_suit( tests, sizeof tests / sizeof *tests );
 }
@@ -0,0 +1,114 @@
+
+/*
+
+<https://github.com/rafagafe/tiny-json>
+     
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2016-2018 Rafa Garcia <rafagarcia77@gmail.com>.
+
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+    
+*/
+
+#include "tiny-json-shared.h"
+
+/* Initialize an array of json properties shared by threads. */
+bool json_initShared( jsonShared_t* shared, json_t mem[], size_t qty, size_t size ) {
+    if ( !size || qty / size > JSON_MAXCHUNKS ) return false;
+    shared->mem  = mem;
+    shared->size = size;
+    shared->qty  = (unsigned int)( qty / size );
+    unsigned int i;
+    for( i = 0; i < shared->qty; ++i )
+        atomic_init( &shared->next[i], i + 1 < shared->qty? i + 2: 0 );
+    atomic_init( &shared->head, shared->qty? 1: 0 );
+    return true;
+}
+
+/** Take a chunk from the stack of free chunks.
+  * @param shared The handler of the shared array.
+  * @return The chunk plus one or zero if there are no free chunks. */
+static uint32_t popChunk( jsonShared_t* shared ) {
+    uint64_t head = atomic_load_explicit( &shared->head, memory_order_acquire );
+    for(;;) {
+        uint32_t const chunk = (uint32_t)head;
+        if ( !chunk ) return 0;
+        uint32_t const next = atomic_load_explicit( &shared->next[ chunk - 1 ], memory_order_relaxed );
+        uint64_t const top = ( ( head >> 32 ) + 1 ) << 32 | next;
+        if ( atomic_compare_exchange_weak_explicit( &shared->head, &head, top,
+                                                    memory_order_acquire, memory_order_acquire ) )
+            return chunk;
+    }
+}
+
+/** Put a list of chunks linked by their next fields on the stack of free chunks.
+  * @param shared The handler of the shared array.
+  * @param first The first chunk plus one.
+  * @param last The last chunk plus one. */
+static void pushChunks( jsonShared_t* shared, uint32_t first, uint32_t last ) {
+    uint64_t head = atomic_load_explicit( &shared->head, memory_order_relaxed );
+    uint64_t top;
+    do {
+        atomic_store_explicit( &shared->next[ last - 1 ], (uint32_t)head, memory_order_relaxed );
+        top = ( ( head >> 32 ) + 1 ) << 32 | first;
+    } while( !atomic_compare_exchange_weak_explicit( &shared->head, &head, top,
+                                                     memory_order_release, memory_order_relaxed ) );
+}
+
+/** Create an instance of a json from the chunks of a context.
+  * @param pool The handler of the pool of a context.
+  * @retval The handler of the new instance if success.
+  * @retval Null pointer if there are no free chunks. */
+static json_t* contextAlloc( jsonPool_t* pool ) {
+    jsonContext_t* const ctx = json_containerOf( pool, jsonContext_t, pool );
+    if ( ctx->free == ctx->end ) {
+        uint32_t const chunk = popChunk( ctx->shared );
+        if ( !chunk ) return 0;
+        atomic_store_explicit( &ctx->shared->next[ chunk - 1 ], 0, memory_order_relaxed );
+        if ( ctx->last ) atomic_store_explicit( &ctx->shared->next[ ctx->last - 1 ], chunk, memory_order_relaxed );
+        else ctx->first = chunk;
+        ctx->last = chunk;
+        ctx->free = ctx->shared->mem + ( chunk - 1 ) * ctx->shared->size;
+        ctx->end  = ctx->free + ctx->shared->size;
+    }
+    return ctx->free++;
+}
+
+/* Start a context to allocate json properties from a shared array. */
+void json_initContext( jsonContext_t* ctx, jsonShared_t* shared ) {
+    ctx->pool.init  = contextAlloc;
+    ctx->pool.alloc = contextAlloc;
+    ctx->shared = shared;
+    ctx->first  = 0;
+    ctx->last   = 0;
+    ctx->free   = 0;
+    ctx->end    = 0;
+}
+
+/* Give back to the shared array all the chunks taken by a context. */
+void json_releaseContext( jsonContext_t* ctx ) {
+    if ( ctx->first ) pushChunks( ctx->shared, ctx->first, ctx->last );
+    json_initContext( ctx, ctx->shared );
+}
+
+/* Parse a string to get a json with the json properties of a context. */
+json_t const* json_createWithContext( char* str, jsonContext_t* ctx, jsonKeys_t* keys, unsigned int options ) {
+    return json_createWithOptions( str, &ctx->pool, keys, options );
+}
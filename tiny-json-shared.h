@@ -0,0 +1,114 @@
+
+/*
+
+<https://github.com/rafagafe/tiny-json>
+     
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2016-2018 Rafa Garcia <rafagarcia77@gmail.com>.
+
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+    
+*/
+
+#ifndef _TINY_JSON_SHARED_H_
+#define	_TINY_JSON_SHARED_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdatomic.h>
+#include "tiny-json.h"
+
+/** @defgroup tinyJsonShared Pool of json properties shared by threads.
+  * It needs C11 atomics.
+  * @{ */
+
+#ifndef JSON_MAXCHUNKS
+/** Maximum number of chunks of a jsonShared_t. */
+#define JSON_MAXCHUNKS 1024
+#endif
+
+/** Structure to handle an array of json properties shared by threads.
+  * It is divided in chunks of the same size. The chunks that are free are kept
+  * in a lock-free stack. Each thread takes chunks with a jsonContext_t and
+  * allocates from them without any synchronization. */
+typedef struct jsonShared_s {
+    json_t* mem;                /**< Pointer to array of json properties.     */
+    size_t size;                /**< Number of json properties of a chunk.    */
+    unsigned int qty;           /**< Number of chunks.                        */
+    _Atomic uint64_t head;      /**< Top of the stack of free chunks: version
+                                     in the high half, chunk plus one in the
+                                     low half, zero if empty.                 */
+    _Atomic uint32_t next[ JSON_MAXCHUNKS ]; /**< Chunk plus one after each one,
+                                     in the stack or in a context.            */
+} jsonShared_t;
+
+/** Structure to allocate json properties from a jsonShared_t in one thread.
+  * Its pool can be passed to any parse function. Its init function allocates
+  * like the alloc one, so nothing is freed until json_releaseContext(). */
+typedef struct jsonContext_s {
+    jsonPool_t pool;      /**< Pool to pass to the parse functions.               */
+    jsonShared_t* shared; /**< The shared array of json properties.               */
+    uint32_t first;       /**< First chunk taken plus one, zero if none.          */
+    uint32_t last;        /**< Last chunk taken plus one, zero if none.           */
+    json_t* free;         /**< First free json property of the last chunk.        */
+    json_t* end;          /**< End of the last chunk.                             */
+} jsonContext_t;
+
+/** Initialize an array of json properties shared by threads.
+  * It must not be used by any thread while it is initialized.
+  * @param shared The handler of the shared array.
+  * @param mem Array of json properties.
+  * @param qty Number of elements of mem.
+  * @param size Number of json properties of a chunk.
+  * @retval true if success.
+  * @retval false if size is zero or there would be more than JSON_MAXCHUNKS chunks. */
+bool json_initShared( jsonShared_t* shared, json_t mem[], size_t qty, size_t size );
+
+/** Start a context to allocate json properties from a shared array.
+  * A context must be used by one thread at a time.
+  * @param ctx The context.
+  * @param shared The handler of the shared array. */
+void json_initContext( jsonContext_t* ctx, jsonShared_t* shared );
+
+/** Give back to the shared array all the chunks taken by a context at once.
+  * Every json parsed with the context becomes invalid. The context can be used again.
+  * @param ctx The context. */
+void json_releaseContext( jsonContext_t* ctx );
+
+/** Parse a string to get a json with the json properties of a context.
+  * The init function of the pool is not used to reset it: the json parsed
+  * before with the context are valid until json_releaseContext().
+  * @param str String pointer with a JSON object. It will be modified.
+  * @param ctx The context.
+  * @param keys Table of interned property names or null pointer.
+  * @param options Combination of codes of jsonOption_t.
+  * @retval Null pointer if any was wrong in the parse process.
+  * @retval If the parser process was successfully a valid handler of a json. */
+json_t const* json_createWithContext( char* str, jsonContext_t* ctx, jsonKeys_t* keys, unsigned int options );
+
+/** @ } */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* _TINY_JSON_SHARED_H_ */
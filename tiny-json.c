@@ -27,27 +27,147 @@
 
 */
 
+#include <stdio.h>
 #include <string.h>
 #include <ctype.h>
+#include <limits.h>
 #include "tiny-json.h"
 
 /** Structure to handle a heap of JSON properties. */
 typedef struct jsonStaticPool_s {
-    json_t* mem;      /**< Pointer to array of json properties.      */
-    unsigned int qty; /**< Length of the array of json properties.   */
-    unsigned int nextFree;  /**< The index of the next free json property. */
+    json_t* mem;     /**< Pointer to array of json properties.            */
+    size_t qty;      /**< Length of the array of json properties.         */
+    size_t nextFree; /**< The index of the next free json property.       */
     jsonPool_t pool;
 } jsonStaticPool_t;
 
+/** Flags of the json properties. */
+enum {
+    integersFlag = 1 << 0, /**< Array packed as a vector of int64_t. */
+    realsFlag    = 1 << 1, /**< Array packed as a vector of double.  */
+    sortedFlag   = 1 << 2, /**< Object with an index sorted by name. */
+    escapedFlag  = 1 << 3, /**< Text with escape sequences to decode. */
+    lastFlag     = JSON_LASTCHILD, /**< Last property: its sibling is its parent. */
+    lengthShift  = 8,      /**< The length of a text is in the bits above. */
+};
+
+/** Get the next property of an object or an array.
+  * @param json A valid handler of a json property.
+  * @retval The handler of the next property if found.
+  * @retval Null pointer if it is the last one. */
+static json_t* nextSibling( json_t const* json ) {
+    return ( json->flags & lastFlag )? 0: json->sibling;
+}
+
+/** Get a property of the sorted index of an object. See JSON_SORT_KEYS.
+  * @param items Pointer to the array of pointers to the properties.
+  * @param pos The position in the index.
+  * @return The handler of the property. */
+static json_t const* indexItem( unsigned char const* items, size_t pos ) {
+    json_t const* item;
+    memcpy( &item, items + pos * sizeof item, sizeof item );
+    return item;
+}
+
+/** Get the length of a name of the sorted index of an object.
+  * @param lens Pointer to the array of lengths of the names.
+  * @param pos The position in the index.
+  * @return The length of the name. */
+static size_t indexLen( unsigned char const* lens, size_t pos ) {
+    size_t len;
+    memcpy( &len, lens + pos * sizeof len, sizeof len );
+    return len;
+}
+
+/** Get the size of the sorted index of an object. It is the number of
+  * properties followed by the pointers to them and the lengths of their names.
+  * The array of lengths has room for the pointers too. See fillIndex().
+  * @param qty Number of properties of the object.
+  * @return The size in bytes. */
+static size_t indexSize( size_t qty ) {
+    size_t const len = sizeof( size_t ) > sizeof( json_t* )? sizeof( size_t ): sizeof( json_t* );
+    return sizeof qty + qty * ( sizeof( json_t* ) + len );
+}
+
+/** Compare a null-terminated name with a name of known length like strcmp().
+  * @param name The null-terminated name.
+  * @param str The other name. It has no null character in its first len ones.
+  * @param len The length of the other name. */
+static int compareName( char const* name, char const* str, size_t len ) {
+    int const cmp = strncmp( name, str, len );
+    return cmp? cmp: (unsigned char)name[ len ];
+}
+
+/** Compare two names of known lengths in the order of strcmp().
+  * @param name A name.
+  * @param namelen The length of the name.
+  * @param str The other name.
+  * @param len The length of the other name. */
+static int compareLen( char const* name, size_t namelen, char const* str, size_t len ) {
+    int const cmp = memcmp( name, str, namelen < len? namelen: len );
+    return cmp? cmp: ( namelen > len ) - ( namelen < len );
+}
+
+/** Search a name in the sorted index of an object with a binary search.
+  * @param items Pointer to the array of pointers to the properties.
+  * @param lens Pointer to the array of lengths of their names.
+  * @param qty Number of properties of the index.
+  * @param name The name to search.
+  * @param len The length of the name.
+  * @return The position of the first property whose name is not less than
+  *         the name. */
+static size_t searchName( unsigned char const* items, unsigned char const* lens, size_t qty, char const* name, size_t len ) {
+    size_t first = 0;
+    while( qty ) {
+        size_t const half = qty / 2;
+        size_t const pos = first + half;
+        if ( 0 > compareLen( indexItem( items, pos )->name, indexLen( lens, pos ), name, len ) ) {
+            first = pos + 1;
+            qty -= half + 1;
+        }
+        else qty = half;
+    }
+    return first;
+}
+
+/** Search a property by its name in a JSON object with a sorted index.
+  * @param obj The handler of the object. It must have the sortedFlag.
+  * @param property The name of property to get.
+  * @param len The length of the name.
+  * @retval The handler of the first json property with the name if found.
+  * @retval Null pointer if not found. */
+static json_t const* sortedProperty( json_t const* obj, char const* property, size_t len ) {
+    unsigned char const* const index = obj->u.a.data;
+    size_t qty;
+    memcpy( &qty, index, sizeof qty );
+    unsigned char const* const items = index + sizeof qty;
+    unsigned char const* const lens = items + qty * sizeof( json_t* );
+    size_t const pos = searchName( items, lens, qty, property, len );
+    if ( pos == qty || indexLen( lens, pos ) != len ) return 0;
+    json_t const* const item = indexItem( items, pos );
+    return memcmp( item->name, property, len )? 0: item;
+}
+
 /* Search a property by its name in a JSON object. */
 json_t const* json_getProperty( json_t const* obj, char const* property ) {
+    if ( obj->flags & sortedFlag ) return sortedProperty( obj, property, strlen( property ) );
     json_t const* sibling;
-    for( sibling = obj->u.c.child; sibling; sibling = sibling->sibling )
+    for( sibling = obj->u.c.child; sibling; sibling = nextSibling( sibling ) )
         if ( sibling->name && !strcmp( sibling->name, property ) )
             return sibling;
     return 0;
 }
 
+/* Search a property by a name of known length in a JSON object. */
+json_t const* json_getPropertyLen( json_t const* obj, char const* property, size_t len ) {
+    if ( obj->flags & sortedFlag ) return sortedProperty( obj, property, len );
+    json_t const* sibling;
+    for( sibling = obj->u.c.child; sibling; sibling = nextSibling( sibling ) )
+        if ( sibling->name && ( !len || *sibling->name == *property ) && !compareName( sibling->name, property, len ) )
+            return sibling;
+    return 0;
+}
+
 /* Search a property by its name in a JSON object and return its value. */
 char const* json_getPropertyValue( json_t const* obj, char const* property ) {
 	json_t const* field = json_getProperty( obj, property );
@@ -57,30 +177,334 @@ char const* json_getPropertyValue( json_t const* obj, char const* property ) {
 	return json_getValue( field );
 }
 
+/** Search a property by its name in a range of properties of an object.
+  * @param first The first property of the range.
+  * @param last The property after the range or null pointer.
+  * @retval The handler of the json property if found.
+  * @retval Null pointer if not found. */
+static json_t const* searchRange( json_t const* first, json_t const* last, char const* property ) {
+    for( ; first != last; first = nextSibling( first ) )
+        if ( !strcmp( first->name, property ) )
+            return first;
+    return 0;
+}
+
+/* Search a property by its name starting after the last one found. */
+json_t const* json_getCursorProperty( jsonCursor_t* cursor, char const* property ) {
+    json_t const* found = searchRange( cursor->next, 0, property );
+    if ( !found ) found = searchRange( cursor->obj->u.c.child, cursor->next, property );
+    if ( found ) cursor->next = nextSibling( found );
+    return found;
+}
+
+/** Get the slot of a name in the table of a jsonLookup_t.
+  * @param name The name.
+  * @param len The length of the name.
+  * @param seed The seed of the hash. It is odd.
+  * @return The position in the table. */
+static unsigned int lookupSlot( char const* name, size_t len, uint32_t seed ) {
+    unsigned char const* const str = (unsigned char const*)name;
+    uint32_t const key = (uint32_t)len ^ (uint32_t)str[0] << 8 ^ (uint32_t)str[ len / 2 ] << 16
+                       ^ (uint32_t)str[ len? len - 1: 0 ] << 24;
+    uint32_t const hash = key * seed;
+    return (unsigned int)( ( (uint64_t)hash * ( 4 * JSON_MAXLOOKUP ) ) >> 32 );
+}
+
+/* Build a set of property names to search together. */
+bool json_initLookup( jsonLookup_t* lookup, char const* const keys[], unsigned int qty ) {
+    if ( qty > JSON_MAXLOOKUP ) return false;
+    lookup->keys = keys;
+    lookup->qty  = qty;
+    unsigned int i;
+    for( i = 0; i < qty; ++i )
+        lookup->len[i] = strlen( keys[i] );
+    uint32_t tries;
+    for( tries = 1; tries <= 1024; ++tries ) {
+        uint32_t const seed = tries * 0x9E3779B9u | 1u;
+        memset( lookup->slot, 0, sizeof lookup->slot );
+        for( i = 0; i < qty; ++i ) {
+            unsigned char* const slot = &lookup->slot[ lookupSlot( keys[i], lookup->len[i], seed ) ];
+            if ( *slot ) break;
+            *slot = (unsigned char)( i + 1 );
+        }
+        if ( i == qty ) {
+            lookup->seed = seed;
+            return true;
+        }
+    }
+    lookup->seed = 0;
+    return true;
+}
+
+/* Search several properties by their names in a JSON object in one pass. */
+unsigned int json_getProperties( json_t const* obj, jsonLookup_t const* lookup, json_t const* out[] ) {
+    unsigned int found = 0;
+    unsigned int i;
+    for( i = 0; i < lookup->qty; ++i )
+        out[i] = 0;
+    json_t const* child;
+    for( child = obj->u.c.child; child && found < lookup->qty; child = nextSibling( child ) ) {
+        if ( !lookup->seed ) {
+            for( i = 0; i < lookup->qty; ++i ) {
+                if ( !out[i] && !strcmp( child->name, lookup->keys[i] ) ) {
+                    out[i] = child;
+                    ++found;
+                }
+            }
+            continue;
+        }
+        size_t const len = strlen( child->name );
+        unsigned int const pos = lookup->slot[ lookupSlot( child->name, len, lookup->seed ) ];
+        if ( !pos || out[ pos - 1 ] || lookup->len[ pos - 1 ] != len ) continue;
+        if ( memcmp( child->name, lookup->keys[ pos - 1 ], len ) ) continue;
+        out[ pos - 1 ] = child;
+        ++found;
+    }
+    return found;
+}
+
+/** Search a property of a column in a JSON object.
+  * @param obj A valid handler of a json object.
+  * @param col The column. Its position is updated if the property is found.
+  * @param cursor The last property found in the object and its position. It is
+  *               used as starting point when the property is expected after it.
+  * @param cursorPos The position of the cursor.
+  * @retval The handler of the json property if found.
+  * @retval Null pointer if not found. */
+static json_t const* columnProperty( json_t const* obj, jsonColumn_t* col, json_t const** cursor, unsigned int* cursorPos ) {
+    json_t const* sibling = *cursor;
+    unsigned int pos = *cursorPos;
+    if ( !sibling || col->pos < pos ) {
+        sibling = obj->u.c.child;
+        pos = 0;
+    }
+    for( ; sibling && pos < col->pos; ++pos )
+        sibling = nextSibling( sibling );
+    if ( !sibling || strcmp( sibling->name, col->name ) ) {
+        for( pos = 0, sibling = obj->u.c.child; sibling; ++pos, sibling = nextSibling( sibling ) )
+            if ( !strcmp( sibling->name, col->name ) )
+                break;
+        if ( !sibling ) return 0;
+        col->pos = pos;
+    }
+    *cursor = sibling;
+    *cursorPos = pos;
+    return sibling;
+}
+
+/** Write the value of a json property in a column.
+  * @param col The column.
+  * @param index The index of the value in the array of the column.
+  * @param property A valid handler of a json property.
+  * @return true if the type of the property is compatible with the column. */
+static bool columnValue( jsonColumn_t const* col, size_t index, json_t const* property ) {
+    jsonType_t const type = property->type;
+    switch( col->type ) {
+        case JSON_INTEGER:
+            if ( type != JSON_INTEGER ) return false;
+            ( (int64_t*)col->out )[index] = json_getInteger( property );
+            return true;
+        case JSON_REAL:
+            if ( type != JSON_REAL && type != JSON_INTEGER ) return false;
+            ( (double*)col->out )[index] = json_getReal( property );
+            return true;
+        case JSON_BOOLEAN:
+            if ( type != JSON_BOOLEAN ) return false;
+            ( (bool*)col->out )[index] = json_getBoolean( property );
+            return true;
+        case JSON_TEXT:
+            if ( type != JSON_TEXT ) return false;
+            ( (char const**)col->out )[index] = json_getText( property );
+            return true;
+        default:
+            return false;
+    }
+}
+
+/* Extract the values of properties from every object of an array in one pass. */
+size_t json_extractColumns( json_t const* array, jsonColumn_t cols[], unsigned int qtycols, size_t qty ) {
+    size_t index = 0;
+    json_t const* element;
+    for( element = array->u.c.child; element && index < qty; element = nextSibling( element ), ++index ) {
+        if ( element->type != JSON_OBJ ) return index;
+        json_t const* cursor = 0;
+        unsigned int cursorPos = 0;
+        unsigned int i;
+        for( i = 0; i < qtycols; ++i ) {
+            json_t const* property = columnProperty( element, cols + i, &cursor, &cursorPos );
+            if ( !property || !columnValue( cols + i, index, property ) ) return index;
+        }
+    }
+    return index;
+}
+
+/* Extract the value of a property from every object of an array. */
+size_t json_extractColumn( json_t const* array, char const* property, jsonType_t type, void* out, size_t qty ) {
+    jsonColumn_t col;
+    col.name = property;
+    col.type = type;
+    col.out  = out;
+    col.pos  = 0;
+    return json_extractColumns( array, &col, 1, qty );
+}
+
 /* Internal prototypes: */
 static char* goBlank( char* str );
-static char* goNum( char* str );
+static char* goNum( char* str, jsonParser_t* parser );
 static json_t* poolInit( jsonPool_t* pool );
 static json_t* poolAlloc( jsonPool_t* pool );
-static char* objValue( char* ptr, json_t* obj, jsonPool_t* pool );
-static char* setToNull( char* ch );
+static char* objValue( char* ptr, json_t** obj, jsonParser_t* parser, size_t budget );
+static char* packedValue( char* ptr, json_t* array, jsonParser_t* parser );
+static bool sortKeys( json_t* obj, jsonParser_t* parser );
+static bool isReadable( jsonParser_t* parser, char const* str, size_t qty );
+static uint64_t load8( char const* str );
+static uint64_t nonDigits8( uint64_t word );
+static uint64_t zeroBytes8( uint64_t word );
+static unsigned int firstByte( uint64_t mask );
+static uint64_t stringStops8( uint64_t word );
+static uint64_t textStops8( uint64_t word );
+static char const* checkString( char const* str, char const* end );
+static bool isBlankChar( char ch );
+static int64_t toInteger( char const* str, char const** stop );
+static double toReal( char const* str, char const** stop );
+static char* setToNull( char* ch, jsonParser_t const* parser );
 static bool isEndOfPrimitive( char ch );
 
-/* Parse a string to get a json. */
-json_t const* json_createWithPool( char *str, jsonPool_t *pool ) {
+/** Allocate the root json and start to parse it.
+  * @param str String pointer with a JSON object. It will be modified.
+  * @param parser The state of the parse process.
+  * @param first Create the root json with the init function of the pool
+  *              instead of the alloc function.
+  * @param root Pointer where the handler of the root json is written.
+  * @param open Pointer where the handler of the root json is written if its
+  *             values are still to be parsed, or null pointer if it is complete.
+  * @retval Null pointer if any was wrong in the parse process.
+  * @retval Pointer to the first character to continue with if success. */
+static char* openRoot( char* str, jsonParser_t* parser, bool first, json_t** root, json_t** open ) {
     char* ptr = goBlank( str );
     if ( !ptr || (*ptr != '{' && *ptr != '[') ) return 0;
-    json_t* obj = pool->init( pool );
+    json_t* obj = first? parser->pool->init( parser->pool ): parser->pool->alloc( parser->pool );
+    if ( !obj ) return 0;
     obj->name    = 0;
     obj->sibling = 0;
     obj->u.c.child = 0;
-    ptr = objValue( ptr, obj, pool );
+    obj->flags   = 0;
+    *root = obj;
+    if ( *ptr == '[' && ( parser->options & JSON_PACK_NUMBERS ) ) {
+        char* const packed = packedValue( ptr, obj, parser );
+        if ( packed ) {
+            *open = 0;
+            return packed;
+        }
+    }
+    obj->type = *ptr == '{' ? JSON_OBJ : JSON_ARRAY;
+    *open = obj;
+    return ++ptr;
+}
+
+/** Parse a string to get a json.
+  * @param str String pointer with a JSON object. It will be modified.
+  * @param parser The state of the parse process.
+  * @param first Create the root json with the init function of the pool
+  *              instead of the alloc function.
+  * @param end Pointer where the pointer to the first character after the
+  *            json is written if success. It can be null.
+  * @retval Null pointer if any was wrong in the parse process.
+  * @retval The handler of the root json if success. */
+static json_t const* create( char* str, jsonParser_t* parser, bool first, char** end ) {
+    json_t* root;
+    json_t* open;
+    char* ptr = openRoot( str, parser, first, &root, &open );
+    if ( ptr && open ) ptr = objValue( ptr, &open, parser, SIZE_MAX );
     if ( !ptr ) return 0;
-    return obj;
+    if ( end ) *end = ptr;
+    return root;
+}
+
+/* Parse a string to get a json. */
+json_t const* json_createWithPool( char *str, jsonPool_t *pool ) {
+    jsonParser_t parser = { pool, 0, 0, str, false, false };
+    return create( str, &parser, true, 0 );
+}
+
+/* Parse a string to get a json and intern the names of its properties. */
+json_t const* json_createWithKeys( char* str, jsonPool_t* pool, jsonKeys_t* keys ) {
+    jsonParser_t parser = { pool, keys, 0, str, false, false };
+    return create( str, &parser, true, 0 );
+}
+
+/* Parse a string to get a json with optional modes. */
+json_t const* json_createWithOptions( char* str, jsonPool_t* pool, jsonKeys_t* keys, unsigned int options ) {
+    jsonParser_t parser = { pool, keys, options, str, false, false };
+    return create( str, &parser, true, 0 );
+}
+
+/* Start a parse process in steps. */
+void json_initStep( jsonStep_t* step, char* str, jsonPool_t* pool, jsonKeys_t* keys, unsigned int options ) {
+    jsonParser_t const parser = { pool, keys, options, str, false, false };
+    step->parser = parser;
+    step->ptr  = str;
+    step->open = 0;
+    step->root = 0;
+}
+
+/* Parse a bounded number of characters of a parse process in steps. */
+jsonStepStatus_t json_parseStep( jsonStep_t* step, size_t budget ) {
+    if ( !step->ptr ) return JSON_STEP_ERROR;
+    if ( !step->root ) {
+        json_t* root;
+        step->ptr = openRoot( step->ptr, &step->parser, true, &root, &step->open );
+        if ( !step->ptr ) return JSON_STEP_ERROR;
+        step->root = root;
+    }
+    if ( step->open ) step->ptr = objValue( step->ptr, &step->open, &step->parser, budget );
+    if ( !step->ptr ) return JSON_STEP_ERROR;
+    return step->open? JSON_STEP_MORE: JSON_STEP_DONE;
+}
+
+/** Check whether a string has only white spaces.
+  * @param str String pointer.
+  * @return The pointer to the null character or null pointer if any other was found. */
+static char* isBlank( char* str ) {
+    while( *str == ' ' || *str == '\n' || *str == '\r' || *str == '\t' || *str == '\f' ) ++str;
+    return *str == '\0'? str: 0;
+}
+
+/* Parse the next JSON document of a string that holds many of them. */
+json_t const* json_createNext( char* str, jsonPool_t* pool, char** end ) {
+    jsonParser_t parser = { pool, 0, 0, str, false, false };
+    json_t const* json = create( str, &parser, true, end );
+    if ( !json ) *end = isBlank( str );
+    return json;
+}
+
+/* Parse consecutive JSON documents of a string. */
+size_t json_createBatch( char* str, jsonPool_t* pool, json_t const* roots[], size_t qty, char** end ) {
+    jsonParser_t parser = { pool, 0, 0, str, false, false };
+    size_t i;
+    for( i = 0; i < qty; ++i ) {
+        roots[i] = create( str, &parser, 0 == i, &str );
+        if ( !roots[i] ) {
+            *end = isBlank( str );
+            return i;
+        }
+    }
+    *end = str;
+    return i;
+}
+
+/* Parse a string that is not null-terminated to get a json. */
+json_t const* json_createN( char* str, size_t len, jsonPool_t* pool ) {
+    if ( memchr( str, '\0', len ) ) return 0;
+    char const* last = str + len;
+    while( last > str && isBlankChar( last[-1] ) ) --last;
+    if ( last == str || ( last[-1] != '}' && last[-1] != ']' ) ) return 0;
+    jsonParser_t parser = { pool, 0, 0, last, true, true };
+    return create( str, &parser, true, 0 );
 }
 
 /* Parse a string to get a json. */
-json_t const* json_create( char* str, json_t mem[], unsigned int qty ) {
+json_t const* json_create( char* str, json_t mem[], size_t qty ) {
     jsonStaticPool_t spool;
     spool.mem = mem;
     spool.qty = qty;
@@ -89,6 +513,70 @@ json_t const* json_create( char* str, json_t mem[], unsigned int qty ) {
     return json_createWithPool( str, &spool.pool );
 }
 
+/* Initialize an empty table of interned property names. */
+void json_initKeys( jsonKeys_t* keys, jsonKey_t mem[], unsigned int qty, char buf[], size_t size ) {
+    unsigned int i;
+    for( i = 0; i < qty; ++i )
+        mem[i].name = 0;
+    keys->mem  = mem;
+    keys->qty  = qty;
+    keys->buf  = buf;
+    keys->size = size;
+    keys->used = 0;
+}
+
+/* Get the hash of a property name used by the tables of interned names. */
+uint32_t json_hashKey( char const* name ) {
+    uint32_t hash = 2166136261u;
+    for( ; *name; ++name ) {
+        hash ^= (unsigned char)*name;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/** Get the entry of a name in a table of interned property names.
+  * @param keys The table.
+  * @param name Pointer to null-terminated string.
+  * @param hash The hash of the name.
+  * @retval The entry with the name or the free entry where it must be added.
+  * @retval Null pointer if the name is not found and the table is full. */
+static jsonKey_t* keyEntry( jsonKeys_t const* keys, char const* name, uint32_t hash ) {
+    unsigned int i;
+    unsigned int pos = hash % keys->qty;
+    for( i = 1; i < keys->qty; ++i ) {
+        jsonKey_t* entry = keys->mem + pos;
+        if ( !entry->name ) return entry;
+        if ( entry->hash == hash && !strcmp( entry->name, name ) ) return entry;
+        if ( ++pos == keys->qty ) pos = 0;
+    }
+    return 0;
+}
+
+/* Search a name in a table of interned property names. */
+char const* json_findKey( jsonKeys_t const* keys, char const* name, uint32_t hash ) {
+    if ( !keys->qty ) return 0;
+    jsonKey_t const* entry = keyEntry( keys, name, hash );
+    return entry? entry->name: 0;
+}
+
+/* Add a name to a table of interned property names. */
+char const* json_internKey( jsonKeys_t* keys, char const* name ) {
+    if ( !keys->qty ) return 0;
+    uint32_t const hash = json_hashKey( name );
+    jsonKey_t* entry = keyEntry( keys, name, hash );
+    if ( !entry ) return 0;
+    if ( entry->name ) return entry->name;
+    size_t const len = strlen( name ) + 1;
+    if ( len > keys->size - keys->used ) return 0;
+    char* canonical = keys->buf + keys->used;
+    memcpy( canonical, name, len );
+    keys->used += len;
+    entry->name = canonical;
+    entry->hash = hash;
+    return canonical;
+}
+
 /** Get a special character with its escape character. Examples:
   * 'b' -> '\\b', 'n' -> '\\n', 't' -> '\\t'
   * @param ch The escape character.
@@ -107,58 +595,269 @@ static char getEscape( char ch ) {
     return '\0';
 }
 
-/** Parse 4 characters.
-  * @param str Pointer to  first digit.
-  * @retval '?' If the four characters are hexadecimal digits.
-  * @retval '\0' In other cases. */
-static unsigned char getCharFromUnicode( unsigned char const* str ) {
+/** Get the value of four hexadecimal digits.
+  * @param str Pointer to the first digit.
+  * @return The value, or a value greater than 0xFFFF if any is not a digit. */
+static uint32_t hex4( unsigned char const* str ) {
+    uint32_t value = 0;
+    unsigned int i;
+    for( i = 0; i < 4; ++i ) {
+        unsigned char const ch = str[i];
+        if ( !isxdigit( ch ) ) return 0x10000;
+        value = value * 16 + (uint32_t)( ch <= '9'? ch - '0': ( ch | 0x20 ) - 'a' + 10 );
+    }
+    return value;
+}
+
+/** Parse a \u escape sequence, joined with the next one if they are a
+  * surrogate pair. The lone surrogates and the null character are rejected.
+  * @param str Pointer to the character 'u'.
+  * @param avail Number of characters that can be read from str.
+  * @param point Pointer where the code point is written.
+  * @return The number of characters from the 'u' to the end of the sequence,
+  *         or zero if it is not valid. */
+static unsigned int unicodeEscape( unsigned char const* str, size_t avail, uint32_t* point ) {
+    if ( avail < 5 ) return 0;
+    uint32_t const high = hex4( str + 1 );
+    if ( high == 0 || high > 0xFFFF || ( high >= 0xDC00 && high <= 0xDFFF ) ) return 0;
+    if ( high < 0xD800 || high > 0xDBFF ) {
+        *point = high;
+        return 5;
+    }
+    if ( avail < 11 || str[5] != '\\' || str[6] != 'u' ) return 0;
+    uint32_t const low = hex4( str + 7 );
+    if ( low < 0xDC00 || low > 0xDFFF ) return 0;
+    *point = 0x10000 + ( ( high - 0xD800 ) << 10 ) + ( low - 0xDC00 );
+    return 11;
+}
+
+/** Get the length of an escape sequence checking it.
+  * @param str Pointer to the character after the backslash.
+  * @param avail Number of characters that can be read from str.
+  * @return The number of characters after the backslash, or zero if it is not valid. */
+static unsigned int escapeLength( unsigned char const* str, size_t avail ) {
+    if ( !avail ) return 0;
+    if ( *str == 'u' ) {
+        uint32_t point;
+        return unicodeEscape( str, avail, &point );
+    }
+    return getEscape( (char)*str )? 1: 0;
+}
+
+/** Get the length of a UTF-8 sequence checking it. The overlong encodings,
+  * the surrogates and the code points beyond U+10FFFF are rejected.
+  * @param str Pointer to the first byte.
+  * @param avail Number of bytes that can be read from str. The bytes are read
+  *        one at a time, so it can be larger if the string is null-terminated.
+  * @return The number of bytes, or zero if it is not valid. */
+static unsigned int utf8Length( unsigned char const* str, size_t avail ) {
+    unsigned char const lead = str[0];
+    if ( lead < 0x80 ) return 1;
+    unsigned int len;
+    unsigned char min = 0x80;
+    unsigned char max = 0xBF;
+    if ( lead < 0xC2 ) return 0;
+    else if ( lead < 0xE0 ) len = 2;
+    else if ( lead < 0xF0 ) {
+        len = 3;
+        if ( lead == 0xE0 ) min = 0xA0;
+        if ( lead == 0xED ) max = 0x9F;
+    }
+    else if ( lead < 0xF5 ) {
+        len = 4;
+        if ( lead == 0xF0 ) min = 0x90;
+        if ( lead == 0xF4 ) max = 0x8F;
+    }
+    else return 0;
+    if ( avail < len || str[1] < min || str[1] > max ) return 0;
     unsigned int i;
-    for( i = 0; i < 4; ++i )
-        if ( !isxdigit( str[i] ) )
-            return '\0';
-    return '?';
+    for( i = 2; i < len; ++i )
+        if ( ( str[i] & 0xC0 ) != 0x80 )
+            return 0;
+    return len;
+}
+
+/** Write a code point in UTF-8.
+  * @param point The code point.
+  * @param dst Pointer where the first byte is written.
+  * @return Pointer to the last byte written. */
+static unsigned char* encodeUtf8( uint32_t point, unsigned char* dst ) {
+    if ( point < 0x80 ) {
+        *dst = (unsigned char)point;
+        return dst;
+    }
+    if ( point < 0x800 ) {
+        *dst = (unsigned char)( 0xC0 | point >> 6 );
+    }
+    else if ( point < 0x10000 ) {
+        *dst = (unsigned char)( 0xE0 | point >> 12 );
+        *++dst = (unsigned char)( 0x80 | ( point >> 6 & 0x3F ) );
+    }
+    else {
+        *dst = (unsigned char)( 0xF0 | point >> 18 );
+        *++dst = (unsigned char)( 0x80 | ( point >> 12 & 0x3F ) );
+        *++dst = (unsigned char)( 0x80 | ( point >> 6 & 0x3F ) );
+    }
+    *++dst = (unsigned char)( 0x80 | ( point & 0x3F ) );
+    return dst;
+}
+
+/** Decode an escape sequence. The \u sequences are written in UTF-8, which
+  * never takes more characters than the sequence.
+  * @param head Pointer to the pointer to the backslash. It is updated to
+  *             the last character of the sequence.
+  * @param tail Pointer to the pointer where the decoded character is written.
+  *             It is updated to the last character written.
+  * @return true if it is a valid escape sequence. */
+static bool decodeEscape( unsigned char** head, unsigned char** tail ) {
+    unsigned char* ptr = *head + 1;
+    if ( *ptr == 'u' ) {
+        uint32_t point;
+        unsigned int const len = unicodeEscape( ptr, SIZE_MAX, &point );
+        if ( !len ) return false;
+        *tail = encodeUtf8( point, *tail );
+        ptr += len - 1;
+    }
+    else {
+        char const esc = getEscape( (char)*ptr );
+        if ( esc == '\0' ) return false;
+        **tail = (unsigned char)esc;
+    }
+    *head = ptr;
+    return true;
+}
+
+/** Skip the characters of a string that are neither escaped nor special.
+  * The characters are scanned eight at a time and the UTF-8 sequences are
+  * checked on the way, so the text is validated in the same pass.
+  * @param str Pointer to the first character.
+  * @param parser The state of the parse process.
+  * @retval Pointer to the first '\"', '\\' or '\0'. If success.
+  * @retval Null pointer if there is a UTF-8 sequence not valid. */
+static char* scanText( char* str, jsonParser_t* parser ) {
+    for(;;) {
+        for( ; isReadable( parser, str, 8 ); str += 8 ) {
+            uint64_t const mask = textStops8( load8( str ) );
+            if ( mask ) {
+                str += firstByte( mask );
+                break;
+            }
+        }
+        unsigned char const ch = (unsigned char)*str;
+        if ( ch == '\"' || ch == '\\' || ch == '\0' ) return str;
+        unsigned int const len = utf8Length( (unsigned char*)str, SIZE_MAX );
+        if ( !len ) return 0;
+        str += len;
+    }
 }
 
 /** Parse a string and replace the scape characters by their meaning characters.
   * This parser stops when finds the character '\"'. Then replaces '\"' by '\0'.
+  * The runs without escape sequences are moved as a whole.
   * @param str Pointer to first character.
+  * @param parser The state of the parse process.
+  * @param len Pointer where the length of the decoded string is written.
   * @retval Pointer to first non white space after the string. If success.
   * @retval Null pointer if any error occur. */
-static char* parseString( char* str ) {
+static char* parseString( char* str, jsonParser_t* parser, size_t* len ) {
     unsigned char* head = (unsigned char*)str;
     unsigned char* tail = (unsigned char*)str;
-    for( ; *head; ++head, ++tail ) {
+    for(;;) {
+        unsigned char* const run = head;
+        head = (unsigned char*)scanText( (char*)head, parser );
+        if ( !head ) return 0;
+        size_t const runlen = (size_t)( head - run );
+        if ( tail != run ) memmove( tail, run, runlen );
+        tail += runlen;
         if ( *head == '\"' ) {
             *tail = '\0';
+            *len = (size_t)( (char*)tail - str );
             return (char*)++head;
         }
-        if ( *head == '\\' ) {
-            if ( *++head == 'u' ) {
-                char const ch = getCharFromUnicode( ++head );
-                if ( ch == '\0' ) return 0;
-                *tail = ch;
-                head += 3;
-            }
-            else {
-                char const esc = getEscape( *head );
-                if ( esc == '\0' ) return 0;
-                *tail = esc;
-            }
+        if ( *head == '\0' || !decodeEscape( &head, &tail ) ) return 0;
+        ++head;
+        ++tail;
+    }
+}
+
+/** Find the end of a string checking its escape sequences without decoding them.
+  * The character '\"' at the end is replaced by '\0'. See JSON_DEFER_ESCAPES.
+  * @param str Pointer to first character.
+  * @param parser The state of the parse process.
+  * @param escaped Pointer where it is written whether there are escape sequences.
+  * @retval Pointer to first character after the string. If success.
+  * @retval Null pointer if any error occur. */
+static char* skipString( char* str, jsonParser_t* parser, bool* escaped ) {
+    *escaped = false;
+    for(;;) {
+        str = scanText( str, parser );
+        if ( !str ) return 0;
+        if ( *str == '\"' ) {
+            *str = '\0';
+            return ++str;
         }
+        if ( *str == '\0' ) return 0;
+        unsigned int const len = escapeLength( (unsigned char*)str + 1, SIZE_MAX );
+        if ( !len ) return 0;
+        str += 1 + len;
+        *escaped = true;
+    }
+}
+
+/** Store the length of the value of a json text property.
+  * The lengths that do not fit in the flags are stored as the greatest one.
+  * @param json The handler of the json text property.
+  * @param len The number of characters of the value. */
+static void setLength( json_t* json, size_t len ) {
+    unsigned int const max = UINT_MAX >> lengthShift;
+    json->flags &= ( 1u << lengthShift ) - 1;
+    json->flags |= ( len < max? (unsigned int)len: max ) << lengthShift;
+}
+
+/* Get the value of a json text property decoding its escape sequences. */
+char const* json_getText( json_t const* json ) {
+    if ( !( json->flags & escapedFlag ) ) return json->u.value;
+    json_t* const text = (json_t*)json;
+    unsigned char* head = (unsigned char*)text->u.value;
+    unsigned char* tail = head;
+    for( ; *head; ++head, ++tail ) {
+        if ( *head == '\\' ) decodeEscape( &head, &tail );
         else *tail = *head;
     }
-    return 0;
+    *tail = '\0';
+    text->flags &= ~escapedFlag;
+    setLength( text, (size_t)( (char*)tail - text->u.value ) );
+    return text->u.value;
+}
+
+/* Get the length of the value of a json text property. */
+size_t json_getTextLength( json_t const* json ) {
+    char const* const text = json_getText( json );
+    size_t const len = json->flags >> lengthShift;
+    return len < UINT_MAX >> lengthShift? len: strlen( text );
+}
+
+/* Check whether the value of a json text property has escape sequences not decoded. */
+bool json_hasEscapes( json_t const* json ) {
+    return json->flags & escapedFlag;
 }
 
 /** Parse a string to get the name of a property.
   * @param ptr Pointer to first character.
   * @param property The property to assign the name.
+  * @param parser The state of the parse process.
   * @retval Pointer to first of property value. If success.
   * @retval Null pointer if any error occur. */
-static char* propertyName( char* ptr, json_t* property ) {
+static char* propertyName( char* ptr, json_t* property, jsonParser_t* parser ) {
     property->name = ++ptr;
-    ptr = parseString( ptr );
+    if ( parser->bounded && !checkString( ptr, parser->end ) ) return 0;
+    size_t len;
+    ptr = parseString( ptr, parser, &len );
     if ( !ptr ) return 0;
+    if ( parser->keys ) {
+        property->name = json_internKey( parser->keys, property->name );
+        if ( !property->name ) return 0;
+    }
     ptr = goBlank( ptr );
     if ( !ptr ) return 0;
     if ( *ptr++ != ':' ) return 0;
@@ -168,12 +867,22 @@ static char* propertyName( char* ptr, json_t* property ) {
 /** Parse a string to get the value of a property when its type is JSON_TEXT.
   * @param ptr Pointer to first character ('\"').
   * @param property The property to assign the name.
+  * @param parser The state of the parse process.
   * @retval Pointer to first non white space after the string. If success.
   * @retval Null pointer if any error occur. */
-static char* textValue( char* ptr, json_t* property ) {
+static char* textValue( char* ptr, json_t* property, jsonParser_t* parser ) {
     ++property->u.value;
-    ptr = parseString( ++ptr );
+    if ( parser->bounded && !checkString( ptr + 1, parser->end ) ) return 0;
+    size_t len;
+    if ( parser->options & JSON_DEFER_ESCAPES ) {
+        bool escaped;
+        ptr = skipString( ++ptr, parser, &escaped );
+        if ( escaped ) property->flags |= escapedFlag;
+        if ( ptr ) len = (size_t)( ptr - 1 - property->u.value );
+    }
+    else ptr = parseString( ++ptr, parser, &len );
     if ( !ptr ) return 0;
+    setLength( property, len );
     property->type = JSON_TEXT;
     return ptr;
 }
@@ -196,12 +905,13 @@ static char* checkStr( char* ptr, char const* str ) {
   * @param property Property handler to set the value and the type, (true, false or null).
   * @param value String with the primitive literal.
   * @param type The code of the type. ( JSON_BOOLEAN or JSON_NULL )
+  * @param parser The state of the parse process.
   * @retval Pointer to first non white space after the string. If success.
   * @retval Null pointer if any error occur. */
-static char* primitiveValue( char* ptr, json_t* property, char const* value, jsonType_t type ) {
+static char* primitiveValue( char* ptr, json_t* property, char const* value, jsonType_t type, jsonParser_t const* parser ) {
     ptr = checkStr( ptr, value );
     if ( !ptr || !isEndOfPrimitive( *ptr ) ) return 0;
-    ptr = setToNull( ptr );
+    ptr = setToNull( ptr, parser );
     property->type = type;
     return ptr;
 }
@@ -210,76 +920,81 @@ static char* primitiveValue( char* ptr, json_t* property, char const* value, jso
   * If the first character after the value is different of '}' or ']' is set to '\0'.
   * @param ptr Pointer to first character.
   * @param property Property handler to set the value and the type, (true, false or null).
+  * @param parser The state of the parse process.
   * @retval Pointer to first non white space after the string. If success.
   * @retval Null pointer if any error occur. */
-static char* trueValue( char* ptr, json_t* property ) {
-    return primitiveValue( ptr, property, "true", JSON_BOOLEAN );
+static char* trueValue( char* ptr, json_t* property, jsonParser_t const* parser ) {
+    return primitiveValue( ptr, property, "true", JSON_BOOLEAN, parser );
 }
 
 /** Parser a string to get a false value.
   * If the first character after the value is different of '}' or ']' is set to '\0'.
   * @param ptr Pointer to first character.
   * @param property Property handler to set the value and the type, (true, false or null).
+  * @param parser The state of the parse process.
   * @retval Pointer to first non white space after the string. If success.
   * @retval Null pointer if any error occur. */
-static char* falseValue( char* ptr, json_t* property ) {
-    return primitiveValue( ptr, property, "false", JSON_BOOLEAN );
+static char* falseValue( char* ptr, json_t* property, jsonParser_t const* parser ) {
+    return primitiveValue( ptr, property, "false", JSON_BOOLEAN, parser );
 }
 
 /** Parser a string to get a null value.
   * If the first character after the value is different of '}' or ']' is set to '\0'.
   * @param ptr Pointer to first character.
   * @param property Property handler to set the value and the type, (true, false or null).
+  * @param parser The state of the parse process.
   * @retval Pointer to first non white space after the string. If success.
   * @retval Null pointer if any error occur. */
-static char* nullValue( char* ptr, json_t* property ) {
-    return primitiveValue( ptr, property, "null", JSON_NULL );
+static char* nullValue( char* ptr, json_t* property, jsonParser_t const* parser ) {
+    return primitiveValue( ptr, property, "null", JSON_NULL, parser );
 }
 
 /** Analyze the exponential part of a real number.
   * @param ptr Pointer to first character.
+  * @param parser The state of the parse process.
   * @retval Pointer to first non numerical after the string. If success.
   * @retval Null pointer if any error occur. */
-static char* expValue( char* ptr ) {
+static char* expValue( char* ptr, jsonParser_t* parser ) {
     if ( *ptr == '-' || *ptr == '+' ) ++ptr;
     if ( !isdigit( (int)(*ptr) ) ) return 0;
-    ptr = goNum( ++ptr );
+    ptr = goNum( ++ptr, parser );
     return ptr;
 }
 
 /** Analyze the decimal part of a real number.
   * @param ptr Pointer to first character.
+  * @param parser The state of the parse process.
   * @retval Pointer to first non numerical after the string. If success.
   * @retval Null pointer if any error occur. */
-static char* fraqValue( char* ptr ) {
+static char* fraqValue( char* ptr, jsonParser_t* parser ) {
     if ( !isdigit( (int)(*ptr) ) ) return 0;
-    ptr = goNum( ++ptr );
+    ptr = goNum( ++ptr, parser );
     if ( !ptr ) return 0;
     return ptr;
 }
 
-/** Parser a string to get a numerical value.
-  * If the first character after the value is different of '}' or ']' is set to '\0'.
+/** Check the syntax of a numerical value without modifying the string.
   * @param ptr Pointer to first character.
-  * @param property Property handler to set the value and the type: JSON_REAL or JSON_INTEGER.
-  * @retval Pointer to first non white space after the string. If success.
+  * @param property Property handler with the value to set the type: JSON_REAL or JSON_INTEGER.
+  * @param parser The state of the parse process.
+  * @retval Pointer to the first character after the value. If success.
   * @retval Null pointer if any error occur. */
-static char* numValue( char* ptr, json_t* property ) {
+static char* numCheck( char* ptr, json_t* property, jsonParser_t* parser ) {
     if ( *ptr == '-' ) ++ptr;
     if ( !isdigit( (int)(*ptr) ) ) return 0;
     if ( *ptr != '0' ) {
-        ptr = goNum( ptr );
+        ptr = goNum( ptr, parser );
         if ( !ptr ) return 0;
     }
     else if ( isdigit( (int)(*++ptr) ) ) return 0;
     property->type = JSON_INTEGER;
     if ( *ptr == '.' ) {
-        ptr = fraqValue( ++ptr );
+        ptr = fraqValue( ++ptr, parser );
         if ( !ptr ) return 0;
         property->type = JSON_REAL;
     }
     if ( *ptr == 'e' || *ptr == 'E' ) {
-        ptr = expValue( ++ptr );
+        ptr = expValue( ++ptr, parser );
         if ( !ptr ) return 0;
         property->type = JSON_REAL;
     }
@@ -293,43 +1008,201 @@ static char* numValue( char* ptr, json_t* property ) {
         unsigned int const len = ( unsigned int const ) ( ptr - value );
         if ( len > maxdigits ) return 0;
         if ( len == maxdigits ) {
-            char const tmp = *ptr;
-            *ptr = '\0';
             char const* const threshold = negative ? min: max;
-            if ( 0 > strcmp( threshold, value ) ) return 0;
-            *ptr = tmp;
+            if ( 0 > memcmp( threshold, value, len ) ) return 0;
         }
     }
-    ptr = setToNull( ptr );
     return ptr;
 }
 
+/** Parser a string to get a numerical value.
+  * If the first character after the value is different of '}' or ']' is set to '\0'.
+  * @param ptr Pointer to first character.
+  * @param property Property handler to set the value and the type: JSON_REAL or JSON_INTEGER.
+  * @param parser The state of the parse process.
+  * @retval Pointer to first non white space after the string. If success.
+  * @retval Null pointer if any error occur. */
+static char* numValue( char* ptr, json_t* property, jsonParser_t* parser ) {
+    ptr = numCheck( ptr, property, parser );
+    if ( !ptr ) return 0;
+    ptr = setToNull( ptr, parser );
+    return ptr;
+}
+
+/** Check whether an array has only the characters of numbers, so it can be
+  * packed unless a number is not valid. The digits, commas and points are
+  * skipped eight at a time while there are eight characters left.
+  * @param ptr Pointer to first character ('[').
+  * @param parser The state of the parse process.
+  * @return true if there are only digits, signs, points, exponents, commas
+  *         and white spaces up to the ']'. */
+static bool numbersOnly( char const* ptr, jsonParser_t* parser ) {
+    uint64_t const ones = 0x0101010101010101ull;
+    for( ++ptr;; ) {
+        if ( isReadable( parser, ptr, 8 ) ) {
+            uint64_t const word = load8( ptr );
+            uint64_t const others = nonDigits8( word ) & ~zeroBytes8( word ^ ones * ',' ) & ~zeroBytes8( word ^ ones * '.' );
+            if ( !others ) {
+                ptr += 8;
+                continue;
+            }
+        }
+        char const ch = *ptr++;
+        if ( isdigit( (int)ch ) || ch == ',' || ch == '-' || ch == '.' || ch == '+' ) continue;
+        if ( ch == 'e' || ch == 'E' || isBlankChar( ch ) ) continue;
+        return ch == ']';
+    }
+}
+
+/** Parser a string to get an array made only of numbers as a packed vector.
+  * The vector is stored in consecutive json properties allocated from the pool,
+  * just after its length. The characters of the array are checked before any
+  * json property is allocated, so an array with other values does not take
+  * any. Neither the string nor the array are modified when the array cannot be
+  * packed, so it can be parsed again as usual.
+  * @param ptr Pointer to first character ('[').
+  * @param array The handler of the JSON array.
+  * @param parser The state of the parse process.
+  * @retval Pointer to first character after the array. If success.
+  * @retval Null pointer if the array is empty, has other types of values or
+  *         the pool does not provide consecutive json properties. */
+static char* packedValue( char* ptr, json_t* array, jsonParser_t* parser ) {
+    if ( !numbersOnly( ptr, parser ) ) return 0;
+    json_t* last = 0;
+    unsigned char* header = 0;
+    unsigned char* data = 0;
+    size_t capacity = 0;
+    size_t len = 0;
+    bool real = false;
+    for( ++ptr;; ) {
+        ptr = goBlank( ptr );
+        if ( !ptr ) return 0;
+        if ( *ptr == ',' ) {
+            ++ptr;
+            continue;
+        }
+        if ( *ptr == ']' ) break;
+        if ( *ptr != '-' && !isdigit( (int)*ptr ) ) return 0;
+        json_t number;
+        number.u.value = ptr;
+        char* const next = numCheck( ptr, &number, parser );
+        if ( !next ) return 0;
+        if ( len == capacity ) {
+            json_t* const slot = parser->pool->alloc( parser->pool );
+            if ( !slot ) return 0;
+            if ( !last ) {
+                uintptr_t const align = ( 8 - (uintptr_t)slot % 8 ) % 8;
+                header = (unsigned char*)slot + align;
+                data = header + 8;
+                capacity = ( (unsigned char*)( slot + 1 ) - data ) / 8;
+            }
+            else if ( slot != last + 1 ) return 0;
+            else capacity = ( (unsigned char*)( slot + 1 ) - data ) / 8;
+            last = slot;
+        }
+        char const* stop;
+        if ( number.type == JSON_REAL && !real ) {
+            size_t i;
+            for( i = 0; i < len; ++i ) {
+                int64_t integer;
+                memcpy( &integer, data + i * 8, 8 );
+                double const value = (double)integer;
+                memcpy( data + i * 8, &value, 8 );
+            }
+            real = true;
+        }
+        if ( real ) {
+            double const value = toReal( ptr, &stop );
+            memcpy( data + len * 8, &value, 8 );
+        }
+        else {
+            int64_t const value = toInteger( ptr, &stop );
+            memcpy( data + len * 8, &value, 8 );
+        }
+        ++len;
+        ptr = next;
+    }
+    if ( !len ) return 0;
+    uint64_t const qty = len;
+    memcpy( header, &qty, 8 );
+    array->type = JSON_ARRAY;
+    array->flags |= real? realsFlag: integersFlag;
+    array->u.a.child = 0;
+    array->u.a.data = header;
+    *ptr = '\0';
+    return ++ptr;
+}
+
+/* Get the type of the values of an array packed by json_createWithOptions(). */
+jsonType_t json_getArrayType( json_t const* json ) {
+    if ( json->type != JSON_ARRAY ) return json->type;
+    if ( json->flags & integersFlag ) return JSON_INTEGER;
+    if ( json->flags & realsFlag ) return JSON_REAL;
+    return JSON_ARRAY;
+}
+
+/* Get the number of values of an array packed by json_createWithOptions(). */
+size_t json_getArrayLength( json_t const* json ) {
+    if ( json->type != JSON_ARRAY || !( json->flags & ( integersFlag | realsFlag ) ) ) return 0;
+    uint64_t qty;
+    memcpy( &qty, json->u.a.data, 8 );
+    return (size_t)qty;
+}
+
+/* Get the values of an array packed by json_createWithOptions(). */
+void const* json_getArrayData( json_t const* json ) {
+    if ( json->type != JSON_ARRAY || !( json->flags & ( integersFlag | realsFlag ) ) ) return 0;
+    return (unsigned char const*)json->u.a.data + 8;
+}
+
 /** Add a property to a JSON object or array.
   * @param obj The handler of the JSON object or array.
   * @param property The handler of the property to be added. */
 static void add( json_t* obj, json_t* property ) {
-    property->sibling = 0;
+    property->sibling = obj;
+    property->flags |= lastFlag;
     if ( !obj->u.c.child ){
 	    obj->u.c.child = property;
 	    obj->u.c.last_child = property;
     } else {
 	    obj->u.c.last_child->sibling = property;
+	    obj->u.c.last_child->flags &= ~lastFlag;
 	    obj->u.c.last_child = property;
     }
 }
 
-/** Parser a string to get a json object value.
+/** Parser a string to get a value that is neither an object nor an array.
   * @param ptr Pointer to first character.
-  * @param obj The handler of the JSON root object or array.
-  * @param pool The handler of a json pool for creating json instances.
-  * @retval Pointer to first character after the value. If success.
+  * @param property Property handler to set the value and the type.
+  * @param parser The state of the parse process.
+  * @retval Pointer to the character to continue with. If success.
   * @retval Null pointer if any error occur. */
-static char* objValue( char* ptr, json_t* obj, jsonPool_t* pool ) {
-    obj->type    = *ptr == '{' ? JSON_OBJ : JSON_ARRAY;
-    obj->u.c.child = 0;
-    obj->sibling = 0;
-    ptr++;
+static char* scalarValue( char* ptr, json_t* property, jsonParser_t* parser ) {
+    switch( *ptr ) {
+        case '\"': return textValue( ptr, property, parser );
+        case 't':  return trueValue( ptr, property, parser );
+        case 'f':  return falseValue( ptr, property, parser );
+        case 'n':  return nullValue( ptr, property, parser );
+        default:   return numValue( ptr, property, parser );
+    }
+}
+
+/** Parser a string to get the values of a json object or array.
+  * The sibling of every object or array still open is its parent.
+  * @param ptr Pointer to the next character to parse.
+  * @param objptr Pointer to the handler of the innermost object or array still
+  *               open. It is updated and set to null pointer when the root one
+  *               is complete.
+  * @param parser The state of the parse process.
+  * @param budget Number of characters after which it stops at the end of the
+  *               next value. SIZE_MAX to parse until the root is complete.
+  * @retval Pointer to the character to continue with. If success.
+  * @retval Null pointer if any error occur. */
+static char* objValue( char* ptr, json_t** objptr, jsonParser_t* parser, size_t budget ) {
+    char const* const start = ptr;
+    json_t* obj = *objptr;
     for(;;) {
+        if ( parser->bounded && ptr == parser->end ) return 0;
         ptr = goBlank( ptr );
         if ( !ptr ) return 0;
         if ( *ptr == ',' ) {
@@ -339,18 +1212,26 @@ static char* objValue( char* ptr, json_t* obj, jsonPool_t* pool ) {
         char const endchar = ( obj->type == JSON_OBJ )? '}': ']';
         if ( *ptr == endchar ) {
             *ptr = '\0';
+            if ( obj->type == JSON_OBJ && ( parser->options & ( JSON_SORT_KEYS | JSON_UNIQUE_KEYS ) ) )
+                if ( !sortKeys( obj, parser ) ) return 0;
             json_t* parentObj = obj->sibling;
-            if ( !parentObj ) return ++ptr;
-            obj->sibling = 0;
+            if ( !parentObj ) {
+                *objptr = 0;
+                return ++ptr;
+            }
             obj = parentObj;
-            ++ptr;
+            if ( (size_t)( ++ptr - start ) >= budget ) {
+                *objptr = obj;
+                return ptr;
+            }
             continue;
         }
-        json_t* property = pool->alloc( pool );
+        json_t* property = parser->pool->alloc( parser->pool );
         if ( !property ) return 0;
+        property->flags = 0;
         if( obj->type != JSON_ARRAY ) {
             if ( *ptr != '\"' ) return 0;
-            ptr = propertyName( ptr, property );
+            ptr = propertyName( ptr, property, parser );
             if ( !ptr ) return 0;
         }
         else property->name = 0;
@@ -360,24 +1241,31 @@ static char* objValue( char* ptr, json_t* obj, jsonPool_t* pool ) {
             case '{':
                 property->type    = JSON_OBJ;
                 property->u.c.child = 0;
-                property->sibling = obj;
                 obj = property;
                 ++ptr;
                 break;
             case '[':
+                if ( parser->options & JSON_PACK_NUMBERS ) {
+                    char* const next = packedValue( ptr, property, parser );
+                    if ( next ) {
+                        ptr = next;
+                        break;
+                    }
+                }
                 property->type    = JSON_ARRAY;
                 property->u.c.child = 0;
-                property->sibling = obj;
                 obj = property;
                 ++ptr;
                 break;
-            case '\"': ptr = textValue( ptr, property );  break;
-            case 't':  ptr = trueValue( ptr, property );  break;
-            case 'f':  ptr = falseValue( ptr, property ); break;
-            case 'n':  ptr = nullValue( ptr, property );  break;
-            default:   ptr = numValue( ptr, property );   break;
+            default:
+                ptr = scalarValue( ptr, property, parser );
+                break;
         }
         if ( !ptr ) return 0;
+        if ( (size_t)( ptr - start ) >= budget ) {
+            *objptr = obj;
+            return ptr;
+        }
     }
 }
 
@@ -400,6 +1288,127 @@ static json_t* poolAlloc( jsonPool_t* pool ) {
     return spool->mem + spool->nextFree++;
 }
 
+/** Allocate consecutive json properties from a pool to store raw data.
+  * @param pool The pool.
+  * @param size Number of bytes to store.
+  * @retval Pointer to the first byte if success.
+  * @retval Null pointer if the pool is empty or it does not provide
+  *         consecutive json properties. */
+static unsigned char* poolRun( jsonPool_t* pool, size_t size ) {
+    json_t* const first = pool->alloc( pool );
+    if ( !first ) return 0;
+    json_t* last = first;
+    while( (size_t)( (unsigned char*)( last + 1 ) - (unsigned char*)first ) < size ) {
+        json_t* const slot = pool->alloc( pool );
+        if ( slot != last + 1 ) return 0;
+        last = slot;
+    }
+    return (unsigned char*)first;
+}
+
+/** Check whether an object has properties with the same name.
+  * @param obj The handler of the object.
+  * @return true if any name is repeated. */
+static bool repeatedNames( json_t const* obj ) {
+    json_t const* i;
+    json_t const* j;
+    for( i = obj->u.c.child; i; i = nextSibling( i ) )
+        for( j = nextSibling( i ); j; j = nextSibling( j ) )
+            if ( !strcmp( i->name, j->name ) )
+                return true;
+    return false;
+}
+
+/** Merge two consecutive runs of pointers to properties sorted by name.
+  * The properties of the first run go first when the names are equal.
+  * @param dst Pointer to the array where the merged run is written.
+  * @param src Pointer to the array with the runs.
+  * @param first The position of the first run.
+  * @param mid The position of the second run.
+  * @param last The position after the second run. */
+static void mergeNames( unsigned char* dst, unsigned char const* src, size_t first, size_t mid, size_t last ) {
+    size_t const size = sizeof( json_t* );
+    size_t i = first;
+    size_t j = mid;
+    size_t k;
+    for( k = first; k < last; ++k ) {
+        bool const left = j == last || ( i < mid && 0 >= strcmp( indexItem( src, i )->name, indexItem( src, j )->name ) );
+        memcpy( dst + k * size, src + ( left? i++: j++ ) * size, size );
+    }
+}
+
+/** Sort pointers to properties by name with a bottom-up merge sort.
+  * The properties with the same name keep their order.
+  * @param items Pointer to the array of pointers to the properties.
+  * @param tmp Pointer to an array of the same size for the merges.
+  * @param qty Number of properties.
+  * @return The array with the sorted pointers: items or tmp. */
+static unsigned char* sortNames( unsigned char* items, unsigned char* tmp, size_t qty ) {
+    size_t width;
+    for( width = 1; width < qty; width *= 2 ) {
+        size_t first;
+        for( first = 0; first < qty; first += 2 * width ) {
+            size_t const mid = qty - first > width? first + width: qty;
+            size_t const last = qty - mid > width? mid + width: qty;
+            mergeNames( tmp, items, first, mid, last );
+        }
+        unsigned char* const merged = tmp;
+        tmp = items;
+        items = merged;
+    }
+    return items;
+}
+
+/** Fill the index of the properties of an object sorted by name.
+  * The properties with the same name keep their order of the document. The
+  * array of lengths of the index is used for the merges before it is filled.
+  * @param obj The handler of the object. Its children are complete.
+  * @param index Memory for the index. See indexSize().
+  * @param qty Number of properties of the object.
+  * @param unique Reject the object if it has repeated names.
+  * @retval false if unique is set and the object has repeated names.
+  * @retval true otherwise. */
+static bool fillIndex( json_t* obj, unsigned char* index, size_t qty, bool unique ) {
+    unsigned char* const items = index + sizeof qty;
+    unsigned char* const lens = items + qty * sizeof( json_t* );
+    json_t const* child;
+    size_t pos;
+    for( child = obj->u.c.child, pos = 0; child; child = nextSibling( child ), ++pos )
+        memcpy( items + pos * sizeof child, &child, sizeof child );
+    unsigned char const* const sorted = sortNames( items, lens, qty );
+    if ( sorted != items ) memcpy( items, sorted, qty * sizeof child );
+    for( pos = 0; pos < qty; ++pos ) {
+        char const* const name = indexItem( items, pos )->name;
+        size_t const len = strlen( name );
+        if ( unique && pos && !compareLen( indexItem( items, pos - 1 )->name, indexLen( lens, pos - 1 ), name, len ) )
+            return false;
+        memcpy( lens + pos * sizeof len, &len, sizeof len );
+    }
+    memcpy( index, &qty, sizeof qty );
+    obj->u.a.data = index;
+    obj->flags |= sortedFlag;
+    return true;
+}
+
+/** Build the index of the properties of an object sorted by name.
+  * The index is stored in consecutive json properties of the pool.
+  * See indexSize() and JSON_SORT_KEYS.
+  * @param obj The handler of the object. Its children are complete.
+  * @param parser The state of the parse process.
+  * @retval false if the object has repeated names and JSON_UNIQUE_KEYS is set.
+  * @retval true otherwise, even if the pool could not store the index. */
+static bool sortKeys( json_t* obj, jsonParser_t* parser ) {
+    bool const unique = parser->options & JSON_UNIQUE_KEYS;
+    size_t qty = 0;
+    json_t const* child;
+    for( child = obj->u.c.child; child; child = nextSibling( child ) )
+        ++qty;
+    if ( !qty ) return true;
+    unsigned char* const index = poolRun( parser->pool, indexSize( qty ) );
+    if ( !index ) return !unique || !repeatedNames( obj );
+    return fillIndex( obj, index, qty, unique );
+}
+
 /** Checks whether an character belongs to set.
   * @param ch Character value to be checked.
   * @param set Set of characters. It is just a null-terminated string.
@@ -411,32 +1420,105 @@ static bool isOneOfThem( char ch, char const* set ) {
     return false;
 }
 
-/** Increases a pointer while it points to a character that belongs to a set.
+/** Checks whether a character is a blank: ' ', '\n', '\r', '\t' or '\f'.
+  * @param ch Character value to be checked.
+  * @return true or false there is membership or not. */
+static bool isBlankChar( char ch ) {
+    return ch == ' ' || ( ch >= '\t' && ch <= '\r' && ch != '\v' );
+}
+
+/** Increases a pointer while it points to a white space character.
   * @param str The initial pointer value.
-  * @param set Set of characters. It is just a null-terminated string.
   * @return The final pointer value or null pointer if the null character was found. */
-static char* goWhile( char* str, char const* set ) {
+static char* goBlank( char* str ) {
     for(; *str != '\0'; ++str ) {
-        if ( !isOneOfThem( *str, set ) )
+        if ( !isBlankChar( *str ) )
             return str;
     }
     return 0;
 }
 
-/** Set of characters that defines a blank. */
-static char const* const blank = " \n\r\t\f";
+/** Check whether the machine stores the least significant byte first. */
+static bool isLittleEndian( void ) {
+    uint16_t const word = 1;
+    return *(unsigned char const*)&word;
+}
 
-/** Increases a pointer while it points to a white space character.
-  * @param str The initial pointer value.
-  * @return The final pointer value or null pointer if the null character was found. */
-static char* goBlank( char* str ) {
-    return goWhile( str, blank );
+/** Load eight characters in a word. The first one is the least significant byte.
+  * @param str Pointer to the first character.
+  * @return The word. */
+static uint64_t load8( char const* str ) {
+    uint64_t word;
+    memcpy( &word, str, sizeof word );
+    if ( !isLittleEndian() ) {
+        word = ( ( word & 0x00FF00FF00FF00FFull ) << 8 )  | ( ( word >> 8 )  & 0x00FF00FF00FF00FFull );
+        word = ( ( word & 0x0000FFFF0000FFFFull ) << 16 ) | ( ( word >> 16 ) & 0x0000FFFF0000FFFFull );
+        word = ( word << 32 ) | ( word >> 32 );
+    }
+    return word;
+}
+
+/** Get the bytes of a word of eight characters that are not decimal digits.
+  * @param word Eight characters loaded with load8().
+  * @return A word with the most significant bit set in each non-digit byte. */
+static uint64_t nonDigits8( uint64_t word ) {
+    uint64_t const x = word ^ 0x3030303030303030ull;
+    return ( ( ( x & 0x7F7F7F7F7F7F7F7Full ) + 0x7676767676767676ull ) | x ) & 0x8080808080808080ull;
+}
+
+/** Get the index of the first byte marked by nonDigits8().
+  * @param mask A non-zero mask returned by nonDigits8().
+  * @return The index from 0 to 7. */
+static unsigned int firstByte( uint64_t mask ) {
+#if defined( __GNUC__ )
+    return (unsigned int)__builtin_ctzll( mask ) / 8;
+#else
+    unsigned int i;
+    for( i = 0; !( mask & 0x80 ); ++i ) mask >>= 8;
+    return i;
+#endif
+}
+
+/** Convert eight decimal digits to their value.
+  * @param word Eight digits loaded with load8().
+  * @return The value from 0 to 99999999. */
+static uint32_t parse8( uint64_t word ) {
+    word = ( word & 0x0F0F0F0F0F0F0F0Full ) * 2561 >> 8;
+    word = ( word & 0x00FF00FF00FF00FFull ) * 6553601 >> 16;
+    return (uint32_t)( ( word & 0x0000FFFF0000FFFFull ) * 42949672960001ull >> 32 );
+}
+
+/** Check whether a number of characters can be read without passing the null character.
+  * The string is scanned ahead in blocks only when it is needed, so a parse
+  * process never reads the string beyond the end of the json to be parsed.
+  * @param parser The state of the parse process.
+  * @param str Pointer to the first character to be read.
+  * @param qty Number of characters to be read.
+  * @return true if none of them is beyond the null character. */
+static bool isReadable( jsonParser_t* parser, char const* str, size_t qty ) {
+    enum { block = 256 };
+    if ( parser->end - str >= (ptrdiff_t)qty ) return true;
+    if ( parser->last ) return false;
+    char const* const from = parser->end > str? parser->end: str;
+    char const* const nul = memchr( from, '\0', qty + block );
+    parser->last = nul != 0;
+    parser->end  = nul? nul: from + qty + block;
+    return parser->end - str >= (ptrdiff_t)qty;
 }
 
 /** Increases a pointer while it points to a decimal digit character.
+  * The digits are checked eight at a time while there are eight characters left.
   * @param str The initial pointer value.
+  * @param parser The state of the parse process.
   * @return The final pointer value or null pointer if the null character was found. */
-static char* goNum( char* str ) {
+static char* goNum( char* str, jsonParser_t* parser ) {
+    for( ; isReadable( parser, str, 8 ); str += 8 ) {
+        uint64_t const mask = nonDigits8( load8( str ) );
+        if ( mask ) {
+            str += firstByte( mask );
+            return *str != '\0'? str: 0;
+        }
+    }
     for( ; *str != '\0'; ++str ) {
         if ( !isdigit( (int)(*str) ) )
             return str;
@@ -444,18 +1526,1977 @@ static char* goNum( char* str ) {
     return 0;
 }
 
-/** Set of characters that defines the end of an array or a JSON object. */
+/** Convert the text of a decimal integer.
+  * @param str Pointer to the first character.
+  * @param stop Pointer where the pointer to the first character that is not
+  *             part of the number is written.
+  * @return The value. */
+static int64_t toInteger( char const* str, char const** stop ) {
+    char const* const start = str;
+    bool const negative = *str == '-';
+    if ( negative ) ++str;
+    uint64_t value = 0;
+    unsigned int len = 0;
+    while( len < 8 && isdigit( (int)str[len] ) ) ++len;
+    if ( len == 8 ) {
+        value = parse8( load8( str ) );
+        str += 8;
+        len = 0;
+        while( len < 10 && isdigit( (int)str[len] ) )
+            value = value * 10 + (unsigned)( str[len++] - '0' );
+        if ( len == 10 ) return strtoll( start, (char**)stop, 10 );
+    }
+    else {
+        unsigned int i;
+        for( i = 0; i < len; ++i )
+            value = value * 10 + (unsigned)( str[i] - '0' );
+    }
+    *stop = str + len;
+    return negative? -(int64_t)value: (int64_t)value;
+}
+
+/* Get the value of a json integer property. */
+int64_t json_getInteger( json_t const* property ) {
+    char const* stop;
+    int64_t const value = toInteger( property->u.value, &stop );
+    if ( *stop != '\0' ) return strtoll( property->u.value, (char**)NULL, 10 );
+    return value;
+}
+
+/** Convert the text of a decimal real number with strtod().
+  * The number is rewritten without decimal point, so the locale does not
+  * matter. Beyond the digits a double can tell apart, the rest is only
+  * marked with a last digit of one if any of them is not zero.
+  * @param str Pointer to the first character.
+  * @param stop Pointer where the pointer to the first character that is not
+  *             part of the number is written.
+  * @return The value. */
+static double strtoReal( char const* str, char const** stop ) {
+    char buf[800];
+    size_t const digits = sizeof buf - 24;
+    size_t len = 0;
+    long exponent = 0;
+    bool rest = false;
+    if ( *str == '-' ) buf[ len++ ] = *str++;
+    size_t const first = len;
+    for( ; isdigit( (int)*str ); ++str ) {
+        if ( len == first && *str == '0' ) continue;
+        if ( len < digits ) buf[ len++ ] = *str;
+        else {
+            rest = rest || *str != '0';
+            ++exponent;
+        }
+    }
+    if ( *str == '.' )
+        for( ++str; isdigit( (int)*str ); ++str ) {
+            if ( len == first && *str == '0' ) --exponent;
+            else if ( len < digits ) {
+                buf[ len++ ] = *str;
+                --exponent;
+            }
+            else rest = rest || *str != '0';
+        }
+    if ( *str == 'e' || *str == 'E' ) {
+        bool const negexp = *++str == '-';
+        if ( *str == '-' || *str == '+' ) ++str;
+        long exp = 0;
+        for( ; isdigit( (int)*str ); ++str )
+            if ( exp < 100000 ) exp = exp * 10 + ( *str - '0' );
+        exponent += negexp? -exp: exp;
+    }
+    *stop = str;
+    if ( len == first ) buf[ len++ ] = '0';
+    if ( rest ) {
+        buf[ len++ ] = '1';
+        --exponent;
+    }
+    snprintf( buf + len, sizeof buf - len, "e%ld", exponent );
+    return strtod( buf, NULL );
+}
+
+/** Convert the text of a decimal real number.
+  * @param str Pointer to the first character.
+  * @param stop Pointer where the pointer to the first character that is not
+  *             part of the number is written.
+  * @return The value. */
+static double toReal( char const* str, char const** stop ) {
+    static double const pow10[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    char const* const start = str;
+    bool const negative = *str == '-';
+    if ( negative ) ++str;
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    for( ; isdigit( (int)*str ); ++str, ++digits )
+        mantissa = mantissa * 10 + (unsigned)( *str - '0' );
+    if ( *str == '.' )
+        for( ++str; isdigit( (int)*str ); ++str, ++digits, --exponent )
+            mantissa = mantissa * 10 + (unsigned)( *str - '0' );
+    if ( *str == 'e' || *str == 'E' ) {
+        bool const negexp = *++str == '-';
+        if ( *str == '-' || *str == '+' ) ++str;
+        int exp = 0;
+        for( ; isdigit( (int)*str ) && exp < 1000; ++str )
+            exp = exp * 10 + ( *str - '0' );
+        exponent += negexp? -exp: exp;
+    }
+    /* Exact when the mantissa and the power of ten fit in a double: */
+    if ( digits > 15 || exponent < -22 || exponent > 22 )
+        return strtoReal( start, stop );
+    *stop = str;
+    double value = (double)mantissa;
+    value = exponent < 0? value / pow10[-exponent]: value * pow10[exponent];
+    return negative? -value: value;
+}
+
+/* Get the value of a json real property. */
+double json_getReal( json_t const* property ) {
+    char const* stop;
+    double const value = toReal( property->u.value, &stop );
+    if ( *stop != '\0' ) return strtod( property->u.value, (char**)NULL );
+    return value;
+}
+
+/** Set of characters that defines the end of an array or a JSON object. */
 static char const* const endofblock = "}]";
 
 /** Set a char to '\0' and increase its pointer if the char is different to '}' or ']'.
+  * The char at the end of a bounded parse is left as it is: it is the end of
+  * a part of json_parsePart() and json_joinParts() sets it to '\0'.
   * @param ch Pointer to character.
+  * @param parser The state of the parse process.
   * @return  Final value pointer. */
-static char* setToNull( char* ch ) {
+static char* setToNull( char* ch, jsonParser_t const* parser ) {
+    if ( parser->bounded && ch == parser->end ) return ch;
     if ( !isOneOfThem( *ch, endofblock ) ) *ch++ = '\0';
     return ch;
 }
 
 /** Indicate if a character is the end of a primitive value. */
 static bool isEndOfPrimitive( char ch ) {
-    return ch == ',' || isOneOfThem( ch, blank ) || isOneOfThem( ch, endofblock );
+    return ch == ',' || ch == '}' || ch == ']' || isBlankChar( ch );
+}
+
+#ifndef JSON_MAXDEPTH
+/** Maximum nesting level of objects and arrays for json_validate(). It has no
+  * tree to walk; the walks of trees go up through the last children instead. */
+#define JSON_MAXDEPTH 1024
+#endif
+
+/** Get the bytes of a word of eight characters that are '\"', '\\' or '\0'.
+  * @param word Eight characters loaded with load8().
+  * @return A word with the most significant bit set in the first matching byte. */
+static uint64_t stringStops8( uint64_t word ) {
+    uint64_t const ones = 0x0101010101010101ull;
+    uint64_t const high = 0x8080808080808080ull;
+    uint64_t const quote = word ^ ( ones * '\"' );
+    uint64_t const slash = word ^ ( ones * '\\' );
+    return ( ( ( quote - ones ) & ~quote ) | ( ( slash - ones ) & ~slash ) | ( ( word - ones ) & ~word ) ) & high;
+}
+
+/** Get the bytes of a word of eight characters that are '\"', '\\', '\0' or
+  * not ASCII, that is the first byte where the fast scan of a text stops.
+  * @param word Eight characters loaded with load8().
+  * @return A word with the most significant bit set in the first matching byte. */
+static uint64_t textStops8( uint64_t word ) {
+    return stringStops8( word ) | ( word & 0x8080808080808080ull );
+}
+
+/** Skip white spaces of a string with length without modifying it.
+  * @param str The initial pointer value.
+  * @param end Pointer to the end of the string.
+  * @return The final pointer value or null pointer if the end or a null character was found. */
+static char const* checkBlank( char const* str, char const* end ) {
+    while( str < end && isBlankChar( *str ) ) ++str;
+    return str < end && *str != '\0'? str: 0;
+}
+
+/** Skip decimal digits of a string with length, eight at a time.
+  * @param str The initial pointer value.
+  * @param end Pointer to the end of the string.
+  * @return The pointer to the first character that is not a digit or the end. */
+static char const* checkDigits( char const* str, char const* end ) {
+    for( ; end - str >= 8; str += 8 ) {
+        uint64_t const mask = nonDigits8( load8( str ) );
+        if ( mask ) return str + firstByte( mask );
+    }
+    while( str < end && isdigit( (int)*str ) ) ++str;
+    return str;
+}
+
+/** Check the syntax of a string with the rules of parseString() without modifying it.
+  * The characters are scanned eight at a time looking for quotes, backslashes
+  * and UTF-8 sequences.
+  * @param str Pointer to the first character after the quote.
+  * @param end Pointer to the end of the string.
+  * @retval Pointer to first character after the closing quote. If success.
+  * @retval Null pointer if any error occur. */
+static char const* checkString( char const* str, char const* end ) {
+    for(;;) {
+        for( ; end - str >= 8; str += 8 ) {
+            uint64_t const mask = textStops8( load8( str ) );
+            if ( mask ) {
+                str += firstByte( mask );
+                break;
+            }
+        }
+        while( str < end && *str != '\"' && *str != '\\' && *str != '\0' && !( *str & 0x80 ) ) ++str;
+        if ( str >= end || *str == '\0' ) return 0;
+        if ( *str == '\"' ) return ++str;
+        unsigned int const len = *str == '\\'
+            ? 1 + escapeLength( (unsigned char const*)str + 1, (size_t)( end - str - 1 ) )
+            : utf8Length( (unsigned char const*)str, (size_t)( end - str ) );
+        if ( len <= 1 ) return 0;
+        str += len;
+    }
+}
+
+/** Check the syntax of a literal with the rules of primitiveValue() without modifying it.
+  * @param str Pointer to the first character.
+  * @param end Pointer to the end of the string.
+  * @param literal String with the primitive literal.
+  * @retval Pointer to first character after the literal. If success.
+  * @retval Null pointer if any error occur. */
+static char const* checkLiteral( char const* str, char const* end, char const* literal ) {
+    for( ; *literal; ++str, ++literal )
+        if ( str >= end || *str != *literal )
+            return 0;
+    return str < end && isEndOfPrimitive( *str )? str: 0;
+}
+
+/** Check the syntax of a number with the rules of numValue() without modifying it.
+  * @param str Pointer to the first character.
+  * @param end Pointer to the end of the string.
+  * @retval Pointer to first character after the number. If success.
+  * @retval Null pointer if any error occur. */
+static char const* checkNumber( char const* str, char const* end ) {
+    char const* const value = str;
+    if ( *str == '-' ) ++str;
+    if ( str >= end || !isdigit( (int)*str ) ) return 0;
+    if ( *str != '0' ) str = checkDigits( str, end );
+    else if ( ++str < end && isdigit( (int)*str ) ) return 0;
+    bool integer = true;
+    if ( str < end && *str == '.' ) {
+        if ( ++str >= end || !isdigit( (int)*str ) ) return 0;
+        str = checkDigits( str, end );
+        integer = false;
+    }
+    if ( str < end && ( *str == 'e' || *str == 'E' ) ) {
+        if ( ++str < end && ( *str == '-' || *str == '+' ) ) ++str;
+        if ( str >= end || !isdigit( (int)*str ) ) return 0;
+        str = checkDigits( str, end );
+        integer = false;
+    }
+    if ( str >= end || !isEndOfPrimitive( *str ) ) return 0;
+    if ( integer ) {
+        bool const negative = *value == '-';
+        static char const min[] = "-9223372036854775808";
+        static char const max[] = "9223372036854775807";
+        size_t const maxdigits = ( negative? sizeof min: sizeof max ) - 1;
+        size_t const len = (size_t)( str - value );
+        if ( len > maxdigits ) return 0;
+        if ( len == maxdigits && 0 > memcmp( negative? min: max, value, len ) ) return 0;
+    }
+    return str;
+}
+
+/* Check whether a string would be parsed successfully without parsing it. */
+bool json_validate( char const* str, size_t len ) {
+    unsigned char stack[ ( JSON_MAXDEPTH + 7 ) / 8 ];
+    unsigned int depth = 0;
+    char const* const end = str + len;
+    char const* ptr = checkBlank( str, end );
+    if ( !ptr || (*ptr != '{' && *ptr != '[') ) return false;
+    for(;;) {
+        bool isObj = false;
+        if ( *ptr == '{' || *ptr == '[' ) {
+            if ( depth == JSON_MAXDEPTH ) return false;
+            unsigned char const bit = (unsigned char)( 1u << depth % 8 );
+            if ( *ptr == '{' ) stack[depth / 8] |= bit;
+            else stack[depth / 8] &= (unsigned char)~bit;
+            ++depth;
+            ++ptr;
+        }
+        for(;;) {
+            ptr = checkBlank( ptr, end );
+            if ( !ptr ) return false;
+            isObj = stack[( depth - 1 ) / 8] & ( 1u << ( depth - 1 ) % 8 );
+            if ( *ptr == ',' ) ++ptr;
+            else if ( *ptr == ( isObj? '}': ']' ) ) {
+                ++ptr;
+                if ( !--depth ) return true;
+            }
+            else break;
+        }
+        if ( isObj ) {
+            if ( *ptr != '\"' ) return false;
+            ptr = checkString( ++ptr, end );
+            if ( !ptr ) return false;
+            ptr = checkBlank( ptr, end );
+            if ( !ptr || *ptr++ != ':' ) return false;
+            ptr = checkBlank( ptr, end );
+            if ( !ptr ) return false;
+        }
+        switch( *ptr ) {
+            case '{':
+            case '[':  continue;
+            case '\"': ptr = checkString( ++ptr, end );         break;
+            case 't':  ptr = checkLiteral( ptr, end, "true" );  break;
+            case 'f':  ptr = checkLiteral( ptr, end, "false" ); break;
+            case 'n':  ptr = checkLiteral( ptr, end, "null" );  break;
+            default:   ptr = checkNumber( ptr, end );           break;
+        }
+        if ( !ptr ) return false;
+    }
+}
+
+/** Get the bytes of a word of eight characters that can end a run of
+  * characters to keep outside strings: blanks, control characters and '\"'.
+  * @param word Eight characters loaded with load8().
+  * @return A word with the most significant bit set in the first matching byte. */
+static uint64_t minifyStops8( uint64_t word ) {
+    uint64_t const ones = 0x0101010101010101ull;
+    uint64_t const high = 0x8080808080808080ull;
+    uint64_t const quote = word ^ ( ones * '\"' );
+    return ( ( ( word - ones * 0x21 ) & ~word ) | ( ( quote - ones ) & ~quote ) ) & high;
+}
+
+/** Copy characters to a lower position eight at a time while none of them is a stop.
+  * @param dst Pointer to the destination. It is updated.
+  * @param src Pointer to the source. It is updated to the first stop or the end.
+  * @param end Pointer to the end of the source.
+  * @param stops8 Function that marks the stops of a word of eight characters. */
+static void copyRun( char** dst, char const** src, char const* end, uint64_t (*stops8)( uint64_t ) ) {
+    while( end - *src >= 8 ) {
+        uint64_t const mask = stops8( load8( *src ) );
+        unsigned int const len = mask? firstByte( mask ): 8;
+        memmove( *dst, *src, len );
+        *dst += len;
+        *src += len;
+        if ( mask ) return;
+    }
+}
+
+/* Remove the white spaces of a JSON string that are not inside texts. */
+size_t json_minify( char* str ) {
+    char* dst = str;
+    char const* src = str;
+    char const* const end = str + strlen( str );
+    while( src < end ) {
+        copyRun( &dst, &src, end, minifyStops8 );
+        if ( src == end ) break;
+        if ( isBlankChar( *src ) ) {
+            ++src;
+            continue;
+        }
+        if ( *src != '\"' ) {
+            *dst++ = *src++;
+            continue;
+        }
+        *dst++ = *src++;
+        while( src < end ) {
+            copyRun( &dst, &src, end, stringStops8 );
+            if ( src == end ) break;
+            if ( *src == '\"' ) {
+                *dst++ = *src++;
+                break;
+            }
+            if ( *src == '\\' && end - src >= 2 ) *dst++ = *src++;
+            *dst++ = *src++;
+        }
+    }
+    *dst = '\0';
+    return (size_t)( dst - str );
+}
+
+/** Number in a canonical form to compare and to hash numbers by value:
+  * the reals with an integral value that fits in an int64_t are integers. */
+typedef struct number_s {
+    bool isReal;
+    int64_t integer;
+    double real;
+} number_t;
+
+/** Get the canonical form of a real number. */
+static number_t realNumber( double value ) {
+    number_t number = { true, 0, value };
+    if ( value >= -9223372036854775808.0 && value < 9223372036854775808.0 ) {
+        int64_t const integer = (int64_t)value;
+        if ( (double)integer == value ) {
+            number.isReal = false;
+            number.integer = integer;
+            number.real = 0;
+        }
+    }
+    return number;
+}
+
+/** Get the canonical form of the number of a json property.
+  * @param json A handler of a json property of type JSON_INTEGER or JSON_REAL. */
+static number_t nodeNumber( json_t const* json ) {
+    if ( json->type == JSON_REAL ) return realNumber( json_getReal( json ) );
+    number_t const number = { false, json_getInteger( json ), 0 };
+    return number;
+}
+
+/** Get the canonical form of a value of an array packed with JSON_PACK_NUMBERS.
+  * @param array A handler of a packed array.
+  * @param index The position of the value. */
+static number_t packedNumber( json_t const* array, size_t index ) {
+    unsigned char const* const data = json_getArrayData( array );
+    if ( array->flags & realsFlag ) {
+        double value;
+        memcpy( &value, data + index * 8, 8 );
+        return realNumber( value );
+    }
+    number_t number = { false, 0, 0 };
+    memcpy( &number.integer, data + index * 8, 8 );
+    return number;
+}
+
+/** Compare two numbers in canonical form. */
+static bool sameNumber( number_t a, number_t b ) {
+    if ( a.isReal != b.isReal ) return false;
+    return a.isReal? a.real == b.real: a.integer == b.integer;
+}
+
+/** Check whether a json property is a number. */
+static bool isNumber( json_t const* json ) {
+    return json->type == JSON_INTEGER || json->type == JSON_REAL;
+}
+
+/** Check whether a json property is an array packed with JSON_PACK_NUMBERS. */
+static bool isPacked( json_t const* json ) {
+    return json->type == JSON_ARRAY && ( json->flags & ( integersFlag | realsFlag ) );
+}
+
+/** Check whether a json property is an object or an array with children. */
+static bool hasChildren( json_t const* json ) {
+    return ( json->type == JSON_OBJ || json->type == JSON_ARRAY ) && json->u.c.child;
+}
+
+/** Accumulate bytes in a 32-bit FNV-1a hash. */
+static uint32_t hashBytes( uint32_t hash, void const* data, size_t len ) {
+    unsigned char const* const bytes = data;
+    size_t i;
+    for( i = 0; i < len; ++i ) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/** Spread the bits of a hash so that it can be summed with others. */
+static uint32_t mixHash( uint32_t hash ) {
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6Bu;
+    hash ^= hash >> 13;
+    hash *= 0xC2B2AE35u;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+/** Undo mixHash(). */
+static uint32_t unmixHash( uint32_t hash ) {
+    hash ^= hash >> 16;
+    hash *= 0x7ED1B41Du;
+    hash ^= hash >> 13 ^ hash >> 26;
+    hash *= 0xA5CB9243u;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+/** Get the hash of a number in canonical form. */
+static uint32_t numberHash( number_t number ) {
+    uint32_t const hash = 2166136261u ^ JSON_INTEGER;
+    if ( number.isReal ) return mixHash( hashBytes( hash ^ JSON_REAL, &number.real, 8 ) );
+    return mixHash( hashBytes( hash, &number.integer, 8 ) );
+}
+
+/** Get the number of children of an object or an array. */
+static size_t childrenQty( json_t const* json ) {
+    if ( isPacked( json ) ) return json_getArrayLength( json );
+    size_t qty = 0;
+    json_t const* child;
+    for( child = json->u.c.child; child; child = nextSibling( child ) )
+        ++qty;
+    return qty;
+}
+
+/** Get the hash of a json property without its children.
+  * @param json A json property. The objects and the arrays only hash their type. */
+static uint32_t leafHash( json_t const* json ) {
+    uint32_t const hash = 2166136261u ^ json->type;
+    switch( json->type ) {
+        case JSON_INTEGER:
+        case JSON_REAL:
+            return numberHash( nodeNumber( json ) );
+        case JSON_OBJ:
+        case JSON_ARRAY:
+        case JSON_NULL:
+            return mixHash( hash );
+        case JSON_TEXT: {
+            char const* const text = json_getText( json );
+            return mixHash( hashBytes( hash, text, strlen( text ) ) );
+        }
+        default:
+            return mixHash( hashBytes( hash, json->u.value, strlen( json->u.value ) ) );
+    }
+}
+
+/* The hash of a json is the sum of the hashes of all its properties, each one
+   mixed with a hash of its position. The position of a property of an object is
+   its name and the one of a value of an array is its index, so the order of the
+   properties does not matter and the order of the values does. The position of
+   a child derives from the one of its parent by an invertible mix, so it is
+   recovered when the walk goes up and no stack is needed. */
+
+/** Get the position hash of the first child of an object or an array.
+  * @param child The first child.
+  * @param path The position hash of its parent. */
+static uint32_t firstPath( json_t const* child, uint32_t path ) {
+    path = mixHash( path );
+    return child->name? path ^ json_hashKey( child->name ): path;
+}
+
+/** Get the position hash of the next sibling of a json property.
+  * @param json A json property that is not the last one.
+  * @param path Its position hash. */
+static uint32_t nextPath( json_t const* json, uint32_t path ) {
+    if ( !json->name ) return path + 0x9E3779B1u;
+    return path ^ json_hashKey( json->name ) ^ json_hashKey( json->sibling->name );
+}
+
+/** Get the position hash of the parent of the last property of an object or an array.
+  * @param last The last property.
+  * @param path Its position hash. */
+static uint32_t parentPath( json_t const* last, uint32_t path ) {
+    if ( last->name ) path ^= json_hashKey( last->name );
+    else path -= (uint32_t)( childrenQty( last->sibling ) - 1 ) * 0x9E3779B1u;
+    return unmixHash( path );
+}
+
+/** Get the sum of the hashes of the values of an array packed with JSON_PACK_NUMBERS.
+  * It is the same as if they were children.
+  * @param array A handler of a packed array.
+  * @param path The position hash of the array. */
+static uint32_t packedHash( json_t const* array, uint32_t path ) {
+    uint32_t const first = mixHash( path );
+    size_t const qty = json_getArrayLength( array );
+    uint32_t hash = 0;
+    size_t i;
+    for( i = 0; i < qty; ++i )
+        hash += mixHash( ( first + (uint32_t)i * 0x9E3779B1u ) ^ numberHash( packedNumber( array, i ) ) );
+    return hash;
+}
+
+/* Get a hash of the content of a json property. */
+uint32_t json_hash( json_t const* json ) {
+    json_t const* node = json;
+    uint32_t path = 2166136261u;
+    uint32_t hash = 0;
+    for(;;) {
+        hash += mixHash( path ^ leafHash( node ) );
+        if ( isPacked( node ) ) hash += packedHash( node, path );
+        if ( hasChildren( node ) ) {
+            node = node->u.c.child;
+            path = firstPath( node, path );
+            continue;
+        }
+        for(;;) {
+            if ( node == json ) return mixHash( hash );
+            if ( !( node->flags & lastFlag ) ) {
+                path = nextPath( node, path );
+                node = node->sibling;
+                break;
+            }
+            path = parentPath( node, path );
+            node = node->sibling;
+        }
+    }
+}
+
+/** Compare a packed array with another array value by value.
+  * @param packed A handler of an array packed with JSON_PACK_NUMBERS.
+  * @param other A handler of an array with the same number of values. */
+static bool samePacked( json_t const* packed, json_t const* other ) {
+    size_t const qty = json_getArrayLength( packed );
+    json_t const* child = isPacked( other )? 0: other->u.c.child;
+    size_t i;
+    for( i = 0; i < qty; ++i ) {
+        number_t number;
+        if ( child ) {
+            if ( !isNumber( child ) ) return false;
+            number = nodeNumber( child );
+            child = nextSibling( child );
+        }
+        else number = packedNumber( other, i );
+        if ( !sameNumber( packedNumber( packed, i ), number ) ) return false;
+    }
+    return true;
+}
+
+/** Compare two json properties without descending to their children.
+  * The objects and the arrays only need the same number of children unless
+  * any of them is packed, then the values are compared too. */
+static bool sameValue( json_t const* a, json_t const* b ) {
+    if ( isNumber( a ) && isNumber( b ) ) return sameNumber( nodeNumber( a ), nodeNumber( b ) );
+    if ( a->type != b->type ) return false;
+    switch( a->type ) {
+        case JSON_OBJ:
+        case JSON_ARRAY:
+            if ( childrenQty( a ) != childrenQty( b ) ) return false;
+            if ( isPacked( a ) ) return samePacked( a, b );
+            if ( isPacked( b ) ) return samePacked( b, a );
+            return true;
+        case JSON_NULL:
+            return true;
+        case JSON_TEXT:
+            return !strcmp( json_getText( a ), json_getText( b ) );
+        default:
+            return !strcmp( a->u.value, b->u.value );
+    }
+}
+
+/** Get the object or the array of a json property.
+  * @param json A json property that is not the root. */
+static json_t const* parentOf( json_t const* json ) {
+    while( !( json->flags & lastFlag ) )
+        json = json->sibling;
+    return json->sibling;
+}
+
+/** Get the counterpart of a child in an object or an array from the counterpart
+  * of its previous sibling.
+  * @param parent The object or the array to search in, or null pointer if it
+  *               has not been needed yet. It is updated if it is searched.
+  * @param prev The counterpart of the previous sibling of child.
+  * @param child The child to be matched. It is matched by name in objects.
+  * @retval The counterpart if found.
+  * @retval Null pointer if not found. */
+static json_t const* counterpart( json_t const** parent, json_t const* prev, json_t const* child ) {
+    json_t const* const hint = nextSibling( prev );
+    if ( !child->name || ( hint && !strcmp( hint->name, child->name ) ) ) return hint;
+    if ( !*parent ) *parent = parentOf( prev );
+    return json_getProperty( *parent, child->name );
+}
+
+/* Check whether two json properties have the same content. */
+bool json_equal( json_t const* a, json_t const* b ) {
+    json_t const* const root = a;
+    json_t const* parent = 0;
+    for(;;) {
+        if ( !sameValue( a, b ) ) return false;
+        if ( hasChildren( a ) && !isPacked( b ) ) {
+            parent = b;
+            a = a->u.c.child;
+            b = parent->u.c.child;
+            if ( a->name && strcmp( b->name, a->name ) ) b = json_getProperty( parent, a->name );
+            if ( !b ) return false;
+            continue;
+        }
+        for(;;) {
+            if ( a == root ) return true;
+            if ( !( a->flags & lastFlag ) ) {
+                a = a->sibling;
+                b = counterpart( &parent, b, a );
+                if ( !b ) return false;
+                break;
+            }
+            a = a->sibling;
+            b = parent? parent: parentOf( b );
+            parent = ( b->flags & lastFlag )? b->sibling: 0;
+        }
+    }
+}
+
+/** Alignment of the blocks of raw data of a clone in its string buffer. */
+enum { cloneAlign = 8 };
+
+/** Free space of the string buffer of a clone. */
+typedef struct cloneBuf_s {
+    char* ptr;
+    char* end;
+} cloneBuf_t;
+
+/** Reserve an aligned block of raw data in the string buffer of a clone.
+  * @param buf The string buffer.
+  * @param size Number of bytes to reserve.
+  * @retval Pointer to the block if success.
+  * @retval Null pointer if the buffer is full. */
+static unsigned char* cloneBlock( cloneBuf_t* buf, size_t size ) {
+    size_t const pad = ( cloneAlign - (uintptr_t)buf->ptr % cloneAlign ) % cloneAlign;
+    if ( (size_t)( buf->end - buf->ptr ) < pad + size ) return 0;
+    unsigned char* const block = (unsigned char*)buf->ptr + pad;
+    buf->ptr += pad + size;
+    return block;
+}
+
+/** Copy a null-terminated string in the string buffer of a clone.
+  * @param buf The string buffer.
+  * @param str The string to be copied.
+  * @retval Pointer to the copy if success.
+  * @retval Null pointer if the buffer is full. */
+static char* cloneString( cloneBuf_t* buf, char const* str ) {
+    size_t const len = strlen( str ) + 1;
+    if ( (size_t)( buf->end - buf->ptr ) < len ) return 0;
+    char* const copy = memcpy( buf->ptr, str, len );
+    buf->ptr += len;
+    return copy;
+}
+
+/** Get the number of bytes of the string buffer needed to clone a json
+  * property without its children. Every block of raw data counts its
+  * worst alignment. */
+static size_t cloneBytes( json_t const* json ) {
+    size_t size = json->name? strlen( json->name ) + 1: 0;
+    switch( json->type ) {
+        case JSON_OBJ:
+        case JSON_ARRAY:
+            if ( isPacked( json ) )
+                size += cloneAlign - 1 + 8 + 8 * json_getArrayLength( json );
+            else if ( json->flags & sortedFlag )
+                size += cloneAlign - 1 + indexSize( childrenQty( json ) );
+            return size;
+        case JSON_BOOLEAN:
+        case JSON_NULL:
+            return size;
+        default:
+            return size + strlen( json->u.value ) + 1;
+    }
+}
+
+/** Copy a json property without its children.
+  * @param json The json property to be copied.
+  * @param node An empty json property for the copy.
+  * @param buf The string buffer where the name, the value and the raw data go.
+  * @retval true if success.
+  * @retval false if the string buffer is full. */
+static bool cloneNode( json_t const* json, json_t* node, cloneBuf_t* buf ) {
+    node->sibling = 0;
+    node->name = 0;
+    node->type = json->type;
+    node->flags = json->flags & ~( sortedFlag | lastFlag );
+    if ( json->name && !( node->name = cloneString( buf, json->name ) ) ) return false;
+    switch( json->type ) {
+        case JSON_OBJ:
+        case JSON_ARRAY:
+            node->u.c.child = 0;
+            node->u.c.last_child = 0;
+            if ( isPacked( json ) ) {
+                size_t const size = 8 + 8 * json_getArrayLength( json );
+                unsigned char* const data = cloneBlock( buf, size );
+                if ( !data ) return false;
+                node->u.a.data = memcpy( data, json->u.a.data, size );
+            }
+            return true;
+        case JSON_BOOLEAN:
+            node->u.value = json_getBoolean( json )? "true": "false";
+            return true;
+        case JSON_NULL:
+            node->u.value = "null";
+            return true;
+        default:
+            node->u.value = cloneString( buf, json->u.value );
+            return node->u.value;
+    }
+}
+
+/** Rebuild in the clone of an object the index of its sorted names.
+  * @param json The original object.
+  * @param node The clone of the object with all its children.
+  * @param buf The string buffer where the index goes.
+  * @retval true if success.
+  * @retval false if the string buffer is full. */
+static bool cloneIndex( json_t const* json, json_t* node, cloneBuf_t* buf ) {
+    if ( !( json->flags & sortedFlag ) ) return true;
+    size_t const qty = childrenQty( node );
+    unsigned char* const index = cloneBlock( buf, indexSize( qty ) );
+    return index && fillIndex( node, index, qty, false );
+}
+
+/* Copy a json property and all its children to another pool and buffer. */
+json_t const* json_clone( json_t const* json, jsonPool_t* pool, char* buf, size_t size ) {
+    json_t const* const start = json;
+    cloneBuf_t strings = { buf, buf + size };
+    json_t* const root = pool->init( pool );
+    if ( !root || !cloneNode( json, root, &strings ) ) return 0;
+    json_t* node = root;
+    for(;;) {
+        json_t* parent = node;
+        if ( hasChildren( json ) ) json = json->u.c.child;
+        else for(;;) {
+            if ( json == start ) return root;
+            parent = node->sibling;
+            bool const last = json->flags & lastFlag;
+            json = json->sibling;
+            if ( !last ) break;
+            node = parent;
+            if ( !cloneIndex( json, node, &strings ) ) return 0;
+        }
+        node = pool->alloc( pool );
+        if ( !node || !cloneNode( json, node, &strings ) ) return 0;
+        add( parent, node );
+    }
+}
+
+/* Get the resources needed to clone a json property with json_clone(). */
+bool json_cloneSize( json_t const* json, size_t* qty, size_t* size ) {
+    json_t const* const start = json;
+    *qty = 0;
+    *size = 0;
+    for(;;) {
+        ++*qty;
+        *size += cloneBytes( json );
+        if ( hasChildren( json ) ) {
+            json = json->u.c.child;
+            continue;
+        }
+        while( json != start && ( json->flags & lastFlag ) )
+            json = json->sibling;
+        if ( json == start ) return true;
+        json = json->sibling;
+    }
+}
+
+/** Search an element in a keyed index of an array.
+  * @param index The index.
+  * @param value A json property with the value of the key to search. */
+static json_t const* indexedElement( jsonIndex_t const* index, json_t const* value ) {
+    if ( !index->entries ) return 0;
+    uint32_t const hash = leafHash( value );
+    size_t i;
+    for( i = hash & index->mask;; i = ( i + 1 ) & index->mask ) {
+        jsonIndexEntry_t const* const entry = &index->entries[i];
+        if ( !entry->element ) return 0;
+        if ( entry->hash == hash && sameValue( entry->key, value ) ) return entry->element;
+    }
+}
+
+/** Check whether a json property can be the key of a keyed index. */
+static bool isIndexKey( json_t const* json ) {
+    return json && ( json->type == JSON_TEXT || isNumber( json ) );
+}
+
+/* Build a hash table of the objects of an array by the value of a property. */
+bool json_indexArrayBy( jsonIndex_t* index, json_t const* array, char const* key, jsonPool_t* pool ) {
+    index->entries = 0;
+    index->mask = 0;
+    index->qty = 0;
+    if ( array->type != JSON_ARRAY || isPacked( array ) ) return false;
+    size_t const qty = childrenQty( array );
+    size_t size = 2;
+    while( size < 2 * qty )
+        size <<= 1;
+    jsonIndexEntry_t* const entries = (jsonIndexEntry_t*)poolRun( pool, size * sizeof *entries );
+    if ( !entries ) return false;
+    memset( entries, 0, size * sizeof *entries );
+    index->entries = entries;
+    index->mask = size - 1;
+    json_t const* element;
+    for( element = array->u.c.child; element; element = nextSibling( element ) ) {
+        if ( element->type != JSON_OBJ ) continue;
+        json_t const* const value = json_getProperty( element, key );
+        if ( !isIndexKey( value ) ) continue;
+        uint32_t const hash = leafHash( value );
+        size_t i = hash & index->mask;
+        while( entries[i].element && !( entries[i].hash == hash && sameValue( entries[i].key, value ) ) )
+            i = ( i + 1 ) & index->mask;
+        if ( entries[i].element ) continue;
+        entries[i].element = element;
+        entries[i].key = value;
+        entries[i].hash = hash;
+        ++index->qty;
+    }
+    return true;
+}
+
+/* Search an element in a keyed index by the value of a json property. */
+json_t const* json_getIndexed( jsonIndex_t const* index, json_t const* value ) {
+    return isIndexKey( value )? indexedElement( index, value ): 0;
+}
+
+/* Search an element in a keyed index by a text. */
+json_t const* json_getIndexedText( jsonIndex_t const* index, char const* value ) {
+    json_t probe;
+    probe.type = JSON_TEXT;
+    probe.flags = 0;
+    probe.u.value = value;
+    return indexedElement( index, &probe );
+}
+
+/** Write an integer in decimal.
+  * @param value The integer.
+  * @param digits Buffer of at least 21 bytes.
+  * @return Pointer to the null-terminated string, at the end of the buffer. */
+static char* formatInteger( int64_t value, char digits[24] ) {
+    char* ptr = digits + 24;
+    uint64_t magnitude = value < 0? 0 - (uint64_t)value: (uint64_t)value;
+    *--ptr = '\0';
+    do {
+        *--ptr = (char)( '0' + magnitude % 10 );
+        magnitude /= 10;
+    } while( magnitude );
+    if ( value < 0 ) *--ptr = '-';
+    return ptr;
+}
+
+/* Search an element in a keyed index by an integer. */
+json_t const* json_getIndexedInteger( jsonIndex_t const* index, int64_t value ) {
+    char digits[24];
+    json_t probe;
+    probe.type = JSON_INTEGER;
+    probe.flags = 0;
+    probe.u.value = formatInteger( value, digits );
+    return indexedElement( index, &probe );
+}
+
+/** Write a real number so that it is read back as the same real number.
+  * The decimal separator of the locale is replaced with a point.
+  * @param value The number. It must be finite.
+  * @param digits Buffer of at least 32 bytes.
+  * @return Pointer to the null-terminated string. */
+static char* formatReal( double value, char digits[32] ) {
+    snprintf( digits, 32, "%.17g", value );
+    char* dst = digits;
+    char const* src;
+    bool point = false;
+    bool exponent = false;
+    for( src = digits; *src; ++src ) {
+        if ( isdigit( (unsigned char)*src ) || *src == '-' || *src == '+' ) *dst++ = *src;
+        else if ( *src == 'e' ) {
+            *dst++ = *src;
+            exponent = true;
+        }
+        else if ( !point ) {
+            *dst++ = '.';
+            point = true;
+        }
+    }
+    if ( !point && !exponent ) {
+        *dst++ = '.';
+        *dst++ = '0';
+    }
+    *dst = '\0';
+    return digits;
+}
+
+/** Copy a string to the side buffer of an edit.
+  * @retval Pointer to the copy if success.
+  * @retval Null pointer if the buffer is full. */
+static char* editString( jsonEdit_t* edit, char const* str ) {
+    size_t const len = strlen( str ) + 1;
+    if ( edit->size - edit->len < len ) return 0;
+    char* const copy = memcpy( edit->buf + edit->len, str, len );
+    edit->len += len;
+    return copy;
+}
+
+/** Forget the index sorted by name of an object before its properties change.
+  * The pointer to the last property shares memory with the index. */
+static void unsortKeys( json_t* obj ) {
+    if ( !( obj->flags & sortedFlag ) ) return;
+    obj->flags &= ~sortedFlag;
+    json_t* last = obj->u.c.child;
+    while( last && !( last->flags & lastFlag ) )
+        last = last->sibling;
+    obj->u.c.last_child = last;
+}
+
+/** Change the value of a json property to one without children. */
+static void setValue( json_t const* json, jsonType_t type, char const* value ) {
+    json_t* const property = (json_t*)json;
+    property->type = type;
+    property->flags &= lastFlag;
+    property->u.value = value;
+}
+
+/* Change the value of a json property to null. */
+void json_setNull( json_t const* json ) {
+    setValue( json, JSON_NULL, "null" );
+}
+
+/* Change the value of a json property to a boolean. */
+void json_setBoolean( json_t const* json, bool value ) {
+    setValue( json, JSON_BOOLEAN, value? "true": "false" );
+}
+
+/* Change the value of a json property to an integer. */
+bool json_setInteger( jsonEdit_t* edit, json_t const* json, int64_t value ) {
+    char digits[24];
+    char const* const copy = editString( edit, formatInteger( value, digits ) );
+    if ( !copy ) return false;
+    setValue( json, JSON_INTEGER, copy );
+    return true;
+}
+
+/* Change the value of a json property to a real number. */
+bool json_setReal( jsonEdit_t* edit, json_t const* json, double value ) {
+    if ( value != value || value - value != 0 ) return false;
+    char digits[32];
+    char const* const copy = editString( edit, formatReal( value, digits ) );
+    if ( !copy ) return false;
+    setValue( json, JSON_REAL, copy );
+    return true;
+}
+
+/* Change the value of a json property to a text. */
+bool json_setText( jsonEdit_t* edit, json_t const* json, char const* text ) {
+    char const* const copy = editString( edit, text );
+    if ( !copy ) return false;
+    setValue( json, JSON_TEXT, copy );
+    setLength( (json_t*)json, strlen( copy ) );
+    return true;
+}
+
+/* Change the value of a json property to an empty object or array. */
+bool json_setEmpty( json_t const* json, jsonType_t type ) {
+    if ( type != JSON_OBJ && type != JSON_ARRAY ) return false;
+    json_t* const property = (json_t*)json;
+    property->type = type;
+    property->flags &= lastFlag;
+    property->u.c.child = 0;
+    property->u.c.last_child = 0;
+    return true;
+}
+
+/* Insert a property with a null value in an object or an array. */
+json_t const* json_insert( jsonEdit_t* edit, json_t const* parent, json_t const* before, char const* name ) {
+    json_t* const obj = (json_t*)parent;
+    if ( obj->type != JSON_OBJ && obj->type != JSON_ARRAY ) return 0;
+    if ( isPacked( obj ) || ( obj->type == JSON_OBJ ) != ( name != 0 ) ) return 0;
+    json_t* prev = 0;
+    json_t* next = obj->u.c.child;
+    for( ; next != before; prev = next, next = nextSibling( next ) )
+        if ( !next ) return 0;
+    json_t* const property = edit->pool->alloc( edit->pool );
+    if ( !property ) return 0;
+    property->name = 0;
+    if ( name && !( property->name = editString( edit, name ) ) ) return 0;
+    property->flags = 0;
+    json_setNull( property );
+    unsortKeys( obj );
+    if ( !next ) {
+        add( obj, property );
+        return property;
+    }
+    property->sibling = next;
+    if ( prev ) prev->sibling = property;
+    else obj->u.c.child = property;
+    return property;
+}
+
+/* Remove a property from an object or an array. */
+bool json_remove( json_t const* parent, json_t const* property ) {
+    json_t* const obj = (json_t*)parent;
+    if ( ( obj->type != JSON_OBJ && obj->type != JSON_ARRAY ) || isPacked( obj ) ) return false;
+    json_t* prev = 0;
+    json_t* next = obj->u.c.child;
+    for( ; next != property; prev = next, next = nextSibling( next ) )
+        if ( !next ) return false;
+    unsortKeys( obj );
+    if ( prev ) prev->sibling = next->sibling;
+    else obj->u.c.child = nextSibling( next );
+    if ( obj->u.c.last_child == next ) {
+        obj->u.c.last_child = prev;
+        if ( prev ) prev->flags |= lastFlag;
+    }
+    return true;
+}
+
+/* Change the name of a property of an object. */
+bool json_rename( jsonEdit_t* edit, json_t const* obj, json_t const* property, char const* name ) {
+    if ( obj->type != JSON_OBJ ) return false;
+    json_t const* child = obj->u.c.child;
+    for( ; child != property; child = nextSibling( child ) )
+        if ( !child ) return false;
+    char const* const copy = editString( edit, name );
+    if ( !copy ) return false;
+    unsortKeys( (json_t*)obj );
+    ( (json_t*)property )->name = copy;
+    return true;
+}
+
+/** Output of json_serialize(). What does not fit is counted but not written. */
+typedef struct jsonWriter_s {
+    char* buf;
+    size_t size;
+    size_t len;
+    bool invalid; /**< A value cannot be written as JSON. */
+} jsonWriter_t;
+
+/** Append bytes to the output of json_serialize(). */
+static void writeBytes( jsonWriter_t* writer, char const* data, size_t len ) {
+    if ( writer->len < writer->size ) {
+        size_t const room = writer->size - writer->len;
+        memcpy( writer->buf + writer->len, data, len < room? len: room );
+    }
+    writer->len += len;
+}
+
+/** Append a character to the output of json_serialize(). */
+static void writeChar( jsonWriter_t* writer, char ch ) {
+    writeBytes( writer, &ch, 1 );
+}
+
+/** Append a string in quotes to the output of json_serialize().
+  * @param writer The output.
+  * @param str The string.
+  * @param escape If true, the characters that must be escaped are escaped.
+  *               If false, the string is already encoded as in the document. */
+static void writeString( jsonWriter_t* writer, char const* str, bool escape ) {
+    static char const hex[] = "0123456789abcdef";
+    writeChar( writer, '\"' );
+    char const* run = str;
+    for( ; escape && *str; ++str ) {
+        unsigned char const ch = (unsigned char)*str;
+        if ( ch >= ' ' && ch != '\"' && ch != '\\' ) continue;
+        writeBytes( writer, run, (size_t)( str - run ) );
+        run = str + 1;
+        char seq[6] = { '\\', (char)ch, 0 };
+        size_t len = 2;
+        switch( ch ) {
+            case '\"': case '\\': break;
+            case '\n': seq[1] = 'n'; break;
+            case '\r': seq[1] = 'r'; break;
+            case '\t': seq[1] = 't'; break;
+            case '\b': seq[1] = 'b'; break;
+            case '\f': seq[1] = 'f'; break;
+            default:
+                memcpy( seq + 1, "u00", 3 );
+                seq[4] = hex[ ch >> 4 ];
+                seq[5] = hex[ ch & 15 ];
+                len = 6;
+        }
+        writeBytes( writer, seq, len );
+    }
+    writeBytes( writer, run, strlen( run ) );
+    writeChar( writer, '\"' );
+}
+
+/** Append the values of an array packed with JSON_PACK_NUMBERS. */
+static void writePacked( jsonWriter_t* writer, json_t const* array ) {
+    unsigned char const* const data = json_getArrayData( array );
+    size_t const qty = json_getArrayLength( array );
+    size_t i;
+    writeChar( writer, '[' );
+    for( i = 0; i < qty; ++i ) {
+        char digits[32];
+        char const* str;
+        if ( array->flags & realsFlag ) {
+            double value;
+            memcpy( &value, data + i * 8, 8 );
+            /* A number that overflowed when it was parsed has no JSON spelling. */
+            if ( value != value || value - value != 0 ) writer->invalid = true;
+            str = formatReal( value, digits );
+        }
+        else {
+            int64_t value;
+            memcpy( &value, data + i * 8, 8 );
+            str = formatInteger( value, digits );
+        }
+        if ( i ) writeChar( writer, ',' );
+        writeBytes( writer, str, strlen( str ) );
+    }
+    writeChar( writer, ']' );
+}
+
+/** Append a json property without its children, or the opening of them. */
+static void writeOpen( jsonWriter_t* writer, json_t const* json ) {
+    switch( json->type ) {
+        case JSON_OBJ:
+            writeChar( writer, '{' );
+            return;
+        case JSON_ARRAY:
+            if ( isPacked( json ) ) writePacked( writer, json );
+            else writeChar( writer, '[' );
+            return;
+        case JSON_TEXT:
+            writeString( writer, json->u.value, !( json->flags & escapedFlag ) );
+            return;
+        default:
+            writeBytes( writer, json->u.value, strlen( json->u.value ) );
+    }
+}
+
+/** Append the closing of the children of an object or an array. */
+static void writeClose( jsonWriter_t* writer, json_t const* json ) {
+    writeChar( writer, json->type == JSON_OBJ? '}': ']' );
+}
+
+/* Write a json property and all its children as a JSON string. */
+size_t json_serialize( json_t const* json, char* buf, size_t size ) {
+    json_t const* const start = json;
+    jsonWriter_t writer = { buf, size, 0, false };
+    for(;;) {
+        if ( json != start && json->name ) {
+            writeString( &writer, json->name, true );
+            writeChar( &writer, ':' );
+        }
+        writeOpen( &writer, json );
+        if ( hasChildren( json ) ) {
+            json = json->u.c.child;
+            continue;
+        }
+        if ( ( json->type == JSON_OBJ || json->type == JSON_ARRAY ) && !isPacked( json ) )
+            writeClose( &writer, json );
+        for(;;) {
+            if ( json == start ) {
+                if ( writer.invalid ) writer.len = 0;
+                if ( size ) buf[ writer.len < size? writer.len: size - 1 ] = '\0';
+                return writer.len;
+            }
+            bool const last = json->flags & lastFlag;
+            json = json->sibling;
+            if ( !last ) {
+                writeChar( &writer, ',' );
+                break;
+            }
+            writeClose( &writer, json );
+        }
+    }
+}
+
+/* Start a parse process of a parser generated by json-codegen. */
+void json_initScan( jsonParser_t* parser, char* str, jsonPool_t* pool ) {
+    jsonParser_t const init = { pool, 0, 0, str, false, false };
+    *parser = init;
+}
+
+/* Skip the white spaces of a parse process of a generated parser. */
+char* json_scanBlank( char* str ) {
+    return goBlank( str );
+}
+
+/* Parse the name of a property in a generated parser. */
+char* json_scanName( char* str, jsonParser_t* parser, size_t* len ) {
+    json_t property;
+    str = propertyName( str, &property, parser );
+    if ( str ) *len = strlen( property.name );
+    return str;
+}
+
+/* Parse a text in a generated parser. */
+char* json_scanText( char* str, jsonParser_t* parser, char const** text ) {
+    if ( *str != '\"' ) return 0;
+    json_t property;
+    property.flags = 0;
+    property.u.value = str;
+    str = textValue( str, &property, parser );
+    if ( str ) *text = property.u.value;
+    return str;
+}
+
+/* Parse an integer in a generated parser. */
+char* json_scanInteger( char* str, jsonParser_t* parser, int64_t* value ) {
+    json_t property;
+    property.u.value = str;
+    char* const next = numCheck( str, &property, parser );
+    if ( !next || property.type != JSON_INTEGER ) return 0;
+    char const* stop;
+    *value = toInteger( str, &stop );
+    return next;
+}
+
+/* Parse a number in a generated parser. */
+char* json_scanReal( char* str, jsonParser_t* parser, double* value ) {
+    json_t property;
+    property.u.value = str;
+    char* const next = numCheck( str, &property, parser );
+    if ( !next ) return 0;
+    char const* stop;
+    *value = property.type == JSON_REAL? toReal( str, &stop ): (double)toInteger( str, &stop );
+    return next;
+}
+
+/* Parse a boolean in a generated parser. */
+char* json_scanBoolean( char* str, bool* value ) {
+    char* const next = checkStr( str, *str == 't'? "true": "false" );
+    if ( !next || !isEndOfPrimitive( *next ) ) return 0;
+    *value = *str == 't';
+    return next;
+}
+
+/* Parse any value with the generic parser in a generated parser. */
+char* json_scanValue( char* str, jsonParser_t* parser, json_t const** value ) {
+    if ( *str == '{' || *str == '[' ) {
+        char* end;
+        *value = create( str, parser, true, &end );
+        return *value? end: 0;
+    }
+    json_t* const property = parser->pool->init( parser->pool );
+    if ( !property ) return 0;
+    property->name = 0;
+    property->sibling = 0;
+    property->flags = 0;
+    property->u.value = str;
+    *value = property;
+    return scalarValue( str, property, parser );
+}
+
+/** Get the bytes of a word of eight characters that are in a range.
+  * @param word Eight characters loaded with load8(). None of them can be
+  *             beyond ASCII.
+  * @param lo The first character of the range.
+  * @param hi The last character of the range.
+  * @return A word with the most significant bit set in each byte in the range. */
+static uint64_t inRange8( uint64_t word, unsigned char lo, unsigned char hi ) {
+    uint64_t const ones = 0x0101010101010101ull;
+    return ( word + ones * ( 0x80u - lo ) ) & ~( word + ones * ( 0x7Fu - hi ) ) & 0x8080808080808080ull;
+}
+
+/** Spread the most significant bit of each byte of a mask to the whole byte.
+  * @param mask A word with only most significant bits of bytes set.
+  * @return A word with 0xFF in the bytes that were marked. */
+static uint64_t byteMask( uint64_t mask ) {
+    return ( mask >> 7 ) * 0xFF;
+}
+
+/** Store the bytes of a word, the most significant one first.
+  * @param word The word.
+  * @param dst Destination of the bytes.
+  * @param qty Number of least significant bytes of the word to store. */
+static void storeBytes( uint64_t word, unsigned char* dst, unsigned int qty ) {
+    unsigned int i;
+    for( i = 0; i < qty; ++i )
+        dst[i] = (unsigned char)( word >> 8 * ( qty - 1 - i ) );
+}
+
+/** Get the value of a hexadecimal digit.
+  * @param ch The character.
+  * @return The value from 0 to 15 or 16 if it is not a hexadecimal digit. */
+static unsigned int hexValue( unsigned char ch ) {
+    if ( ch >= '0' && ch <= '9' ) return ch - '0';
+    ch |= 0x20;
+    if ( ch >= 'a' && ch <= 'f' ) return ch - 'a' + 10;
+    return 16;
+}
+
+/** Decode eight hexadecimal digits.
+  * @param word Eight characters loaded with load8().
+  * @param value Destination of the four bytes, the first one as the most
+  *              significant byte.
+  * @return true if all of them are hexadecimal digits. */
+static bool decodeHex8( uint64_t word, uint64_t* value ) {
+    uint64_t const high = 0x8080808080808080ull;
+    if ( word & high ) return false;
+    uint64_t const digits  = inRange8( word, '0', '9' );
+    uint64_t const letters = inRange8( word | 0x2020202020202020ull, 'a', 'f' );
+    if ( ( digits | letters ) != high ) return false;
+    uint64_t const nibbles = ( word & 0x0F0F0F0F0F0F0F0Full ) + ( word >> 6 & 0x0101010101010101ull ) * 9;
+    uint64_t const pairs = ( nibbles & 0x000F000F000F000Full ) << 4 | ( nibbles >> 8 & 0x000F000F000F000Full );
+    uint64_t const quads = ( pairs & 0x000000FF000000FFull ) << 8 | ( pairs >> 16 & 0x000000FF000000FFull );
+    *value = ( quads & 0xFFFF ) << 16 | ( quads >> 32 & 0xFFFF );
+    return true;
+}
+
+/* Decode in place the value of a json text property written in hexadecimal. */
+void const* json_decodeHex( json_t const* json, size_t* size ) {
+    size_t const len = json_getTextLength( json );
+    if ( len % 2 ) return 0;
+    unsigned char* const str = (unsigned char*)json->u.value;
+    size_t i = 0;
+    for( ; i + 8 <= len; i += 8 ) {
+        uint64_t value;
+        if ( !decodeHex8( load8( (char*)str + i ), &value ) ) return 0;
+        storeBytes( value, str + i / 2, 4 );
+    }
+    for( ; i < len; i += 2 ) {
+        unsigned int const hi = hexValue( str[i] );
+        unsigned int const lo = hexValue( str[i + 1] );
+        if ( hi > 15 || lo > 15 ) return 0;
+        str[i / 2] = (unsigned char)( hi << 4 | lo );
+    }
+    *size = len / 2;
+    return str;
+}
+
+/** Get the value of a character of the base64 alphabet.
+  * @param ch The character.
+  * @return The value from 0 to 63 or 64 if it is not in the alphabet. */
+static unsigned int base64Value( unsigned char ch ) {
+    if ( ch >= 'A' && ch <= 'Z' ) return ch - 'A';
+    if ( ch >= 'a' && ch <= 'z' ) return ch - 'a' + 26;
+    if ( ch >= '0' && ch <= '9' ) return ch - '0' + 52;
+    if ( ch == '+' ) return 62;
+    if ( ch == '/' ) return 63;
+    return 64;
+}
+
+/** Decode eight characters of base64.
+  * @param word Eight characters loaded with load8().
+  * @param value Destination of the six bytes, the first one as the most
+  *              significant byte.
+  * @return true if all of them are in the base64 alphabet. */
+static bool decodeBase64x8( uint64_t word, uint64_t* value ) {
+    uint64_t const high = 0x8080808080808080ull;
+    uint64_t const ones = 0x0101010101010101ull;
+    if ( word & high ) return false;
+    uint64_t const upper  = inRange8( word, 'A', 'Z' );
+    uint64_t const lower  = inRange8( word, 'a', 'z' );
+    uint64_t const digits = inRange8( word, '0', '9' );
+    uint64_t const plus   = inRange8( word, '+', '+' );
+    uint64_t const slash  = inRange8( word, '/', '/' );
+    if ( ( upper | lower | digits | plus | slash ) != high ) return false;
+    uint64_t const u = byteMask( upper );
+    uint64_t const l = byteMask( lower );
+    uint64_t const d = byteMask( digits );
+    uint64_t const sextets = ( ( word & u ) - ( ones * 'A' & u ) )
+                           | ( ( word & l ) - ( ones * ( 'a' - 26 ) & l ) )
+                           | ( ( word & d ) + ( ones * 4 & d ) )
+                           | ( ones * 62 & byteMask( plus ) )
+                           | ( ones * 63 & byteMask( slash ) );
+    uint64_t const pairs = ( sextets & 0x003F003F003F003Full ) << 6 | ( sextets >> 8 & 0x003F003F003F003Full );
+    uint64_t const quads = ( pairs & 0x00000FFF00000FFFull ) << 12 | ( pairs >> 16 & 0x00000FFF00000FFFull );
+    *value = ( quads & 0xFFFFFF ) << 24 | ( quads >> 32 & 0xFFFFFF );
+    return true;
+}
+
+/* Decode in place the value of a json text property written in base64. */
+void const* json_decodeBase64( json_t const* json, size_t* size ) {
+    size_t len = json_getTextLength( json );
+    unsigned char* const str = (unsigned char*)json->u.value;
+    if ( len % 4 == 0 && len && str[len - 1] == '=' ) len -= str[len - 2] == '='? 2: 1;
+    if ( len % 4 == 1 ) return 0;
+    size_t i = 0;
+    size_t out = 0;
+    for( ; i + 8 <= len; i += 8, out += 6 ) {
+        uint64_t value;
+        if ( !decodeBase64x8( load8( (char*)str + i ), &value ) ) return 0;
+        storeBytes( value, str + out, 6 );
+    }
+    uint32_t bits = 0;
+    unsigned int qty = 0;
+    for( ; i < len; ++i ) {
+        unsigned int const value = base64Value( str[i] );
+        if ( value > 63 ) return 0;
+        bits = bits << 6 | value;
+        qty += 6;
+        if ( qty >= 8 ) {
+            qty -= 8;
+            str[out++] = (unsigned char)( bits >> qty );
+        }
+    }
+    *size = out;
+    return str;
+}
+
+/** Get the value of two decimal digits.
+  * @param str Pointer to the first digit. They must be checked.
+  * @return The value from 0 to 99. */
+static unsigned int value2( char const* str ) {
+    return (unsigned int)( str[0] - '0' ) * 10 + (unsigned int)( str[1] - '0' );
+}
+
+/** Get the number of days from 1970-01-01 to a date of the Gregorian calendar.
+  * @param year The year.
+  * @param month The month from 1 to 12.
+  * @param day The day of the month from 1.
+  * @return The number of days, negative before 1970. */
+static int64_t daysFromCivil( int64_t year, unsigned int month, unsigned int day ) {
+    year -= month <= 2;
+    int64_t const era = ( year >= 0? year: year - 399 ) / 400;
+    unsigned int const yoe = (unsigned int)( year - era * 400 );
+    unsigned int const doy = ( 153 * ( month > 2? month - 3: month + 9 ) + 2 ) / 5 + day - 1;
+    unsigned int const doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + (int64_t)doe - 719468;
+}
+
+/** Get the number of days of a month of the Gregorian calendar.
+  * @param year The year.
+  * @param month The month from 1 to 12. */
+static unsigned int daysOfMonth( unsigned int year, unsigned int month ) {
+    static unsigned char const days[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    bool const leap = year % 4 == 0 && ( year % 100 != 0 || year % 400 == 0 );
+    return days[ month - 1 ] + ( month == 2 && leap );
+}
+
+/* Get the value of a json text property with a RFC 3339 timestamp. */
+bool json_getTimestamp( json_t const* json, int64_t* ns ) {
+    size_t const len = json_getTextLength( json );
+    char const* const str = json->u.value;
+    if ( len < 20 ) return false;
+    /* "YYYY-MM-" and "DDTHH:MM" with the separators in known bytes. */
+    if ( nonDigits8( load8( str ) ) != 0x8000008000000000ull ) return false;
+    if ( nonDigits8( load8( str + 8 ) ) != 0x0000800000800000ull ) return false;
+    if ( str[4] != '-' || str[7] != '-' || str[13] != ':' || str[16] != ':' ) return false;
+    if ( str[10] != 'T' && str[10] != 't' && str[10] != ' ' ) return false;
+    if ( !isdigit( (int)str[17] ) || !isdigit( (int)str[18] ) ) return false;
+    unsigned int const year   = value2( str ) * 100 + value2( str + 2 );
+    unsigned int const month  = value2( str + 5 );
+    unsigned int const day    = value2( str + 8 );
+    unsigned int const hour   = value2( str + 11 );
+    unsigned int const minute = value2( str + 14 );
+    unsigned int const second = value2( str + 17 );
+    if ( month < 1 || month > 12 || day < 1 || day > daysOfMonth( year, month ) ) return false;
+    if ( hour > 23 || minute > 59 || second > 60 ) return false;
+    char const* ptr = str + 19;
+    char const* const end = str + len;
+    int64_t fraction = 0;
+    if ( *ptr == '.' ) {
+        char const* const first = ++ptr;
+        int64_t scale = 1000000000;
+        for( ; ptr < end && isdigit( (int)*ptr ); ++ptr )
+            if ( scale > 1 ) fraction += ( *ptr - '0' ) * ( scale /= 10 );
+        if ( ptr == first ) return false;
+    }
+    /* The offset is required: exactly one 'Z' or "+HH:MM" at the end. */
+    int64_t offset = 0;
+    if ( ptr + 1 == end && ( *ptr == 'Z' || *ptr == 'z' ) ) ++ptr;
+    else if ( ptr + 6 == end && ( *ptr == '+' || *ptr == '-' ) && ptr[3] == ':' ) {
+        if ( !isdigit( (int)ptr[1] ) || !isdigit( (int)ptr[2] ) ) return false;
+        if ( !isdigit( (int)ptr[4] ) || !isdigit( (int)ptr[5] ) ) return false;
+        unsigned int const hours = value2( ptr + 1 );
+        unsigned int const minutes = value2( ptr + 4 );
+        if ( hours > 23 || minutes > 59 ) return false;
+        offset = ( *ptr == '-'? -1: 1 ) * (int64_t)( hours * 60 + minutes ) * 60;
+        ptr += 6;
+    }
+    else return false;
+    if ( ptr != end ) return false;
+    int64_t const seconds = daysFromCivil( year, month, day ) * 86400
+                          + (int64_t)( hour * 3600 + minute * 60 + second ) - offset;
+    if ( seconds <= INT64_MIN / 1000000000 || seconds >= INT64_MAX / 1000000000 ) return false;
+    *ns = seconds * 1000000000 + fraction;
+    return true;
+}
+
+/* Divide a string with a top-level array in parts to be parsed in parallel. */
+unsigned int json_splitArray( jsonSplit_t* split, char* str, size_t len, unsigned int qty, unsigned int options ) {
+    char* const open = goBlank( str );
+    if ( !open || *open != '[' || !qty ) return 0;
+    if ( qty > JSON_MAXPARTS ) qty = JSON_MAXPARTS;
+    if ( qty > len ) qty = (unsigned int)len;
+    split->str = str;
+    split->len = len;
+    split->options = options;
+    split->qty = qty;
+    unsigned int i;
+    for( i = 0; i < qty; ++i ) {
+        jsonPart_t* const part = &split->part[i];
+        part->begin = str + len / qty * i;
+        part->end = i + 1 < qty? str + len / qty * ( i + 1 ): str + len;
+        part->comma = 0;
+        part->first = 0;
+        part->last = 0;
+        part->array = 0;
+    }
+    split->part[0].first = open + 1;
+    return qty;
+}
+
+/** Check whether a character is escaped by the backslashes just before it.
+  * @param ptr Pointer to the character.
+  * @param str Pointer to the first character of the string.
+  * @return true if the number of backslashes just before it is odd. */
+static bool isEscaped( char const* ptr, char const* str ) {
+    char const* prev = ptr;
+    while( prev > str && prev[-1] == '\\' ) --prev;
+    return ( ptr - prev ) % 2;
+}
+
+/** Get the bytes of a word that are zero.
+  * @param word A word of eight bytes.
+  * @return A word with the most significant bit set in each zero byte, and
+  *         only in them. */
+static uint64_t zeroBytes8( uint64_t word ) {
+    uint64_t const low = 0x7F7F7F7F7F7F7F7Full;
+    return ~( ( ( word & low ) + low ) | word | low );
+}
+
+/** Count the bytes marked in a mask.
+  * @param mask A word with only most significant bits of bytes set.
+  * @return The number of bytes from 0 to 8. */
+static unsigned int countBytes( uint64_t mask ) {
+    return (unsigned int)( ( mask >> 7 ) * 0x0101010101010101ull >> 56 );
+}
+
+/* Scan a part of a string split by json_splitArray(). */
+void json_scanPart( jsonSplit_t* split, unsigned int i ) {
+    uint64_t const ones = 0x0101010101010101ull;
+    jsonPart_t* const part = &split->part[i];
+    char const* ptr = part->begin;
+    char const* const end = part->end;
+    unsigned int quotes = 0;
+    long depth[2] = { 0, 0 };
+    if ( isEscaped( ptr, split->str ) ) ++ptr;
+    for(;;) {
+        /* Eight characters without backslashes at a time: the quotes are
+           counted with a prefix xor to know which brackets are in strings. */
+        if ( end - ptr >= 8 ) {
+            uint64_t const word = load8( ptr );
+            if ( !zeroBytes8( word ^ ones * '\\' ) ) {
+                uint64_t const folded = word | ones * 0x20;
+                uint64_t const opens = zeroBytes8( folded ^ ones * '{' );
+                uint64_t const closes = zeroBytes8( folded ^ ones * '}' );
+                uint64_t parity = zeroBytes8( word ^ ones * '\"' ) >> 7;
+                parity ^= parity << 8;
+                parity ^= parity << 16;
+                parity ^= parity << 32;
+                uint64_t const odd = parity << 7;
+                long const opened = (long)countBytes( opens & odd ) - (long)countBytes( closes & odd );
+                depth[ !quotes ] += opened;
+                depth[ quotes ] += (long)countBytes( opens ) - (long)countBytes( closes ) - opened;
+                quotes ^= (unsigned int)( parity >> 56 );
+                ptr += 8;
+                continue;
+            }
+        }
+        if ( ptr >= end ) break;
+        char const ch = *ptr++;
+        if ( ch == '\\' ) ++ptr;
+        else if ( ch == '\"' ) quotes = !quotes;
+        else if ( ch == '[' || ch == '{' ) ++depth[ quotes ];
+        else if ( ch == ']' || ch == '}' ) --depth[ quotes ];
+    }
+    part->quotes = quotes;
+    part->depth[0] = depth[0];
+    part->depth[1] = depth[1];
+}
+
+/** Find the first comma between two elements of a top-level array in a part.
+  * @param part The part. Its state at the first character is known.
+  * @param str Pointer to the first character of the string.
+  * @return The pointer to the comma or null pointer if there is not any. */
+static char* firstComma( jsonPart_t const* part, char const* str ) {
+    char* ptr = part->begin;
+    bool inString = part->inString;
+    long depth = part->start;
+    if ( isEscaped( ptr, str ) ) ++ptr;
+    for( ; ptr < part->end; ++ptr ) {
+        char const ch = *ptr;
+        if ( ch == '\\' ) ++ptr;
+        else if ( ch == '\"' ) inString = !inString;
+        else if ( inString ) continue;
+        else if ( ch == ',' && depth == 1 ) return ptr;
+        else if ( ch == '[' || ch == '{' ) ++depth;
+        else if ( ch == ']' || ch == '}' ) {
+            if ( --depth == 0 ) return 0;
+        }
+    }
+    return 0;
+}
+
+/* Find the elements of the top-level array where each part starts and ends. */
+bool json_findElements( jsonSplit_t* split ) {
+    bool inString = false;
+    long depth = 0;
+    unsigned int i;
+    for( i = 0; i < split->qty; ++i ) {
+        jsonPart_t* const part = &split->part[i];
+        part->inString = inString;
+        part->start = depth;
+        depth += part->depth[ inString ];
+        inString ^= part->quotes;
+    }
+    if ( inString || depth ) return false;
+    jsonPart_t* prev = &split->part[0];
+    for( i = 1; i < split->qty; ++i ) {
+        jsonPart_t* const part = &split->part[i];
+        part->comma = firstComma( part, split->str );
+        if ( !part->comma ) continue;
+        part->first = goBlank( part->comma + 1 );
+        char* last = part->comma;
+        while( last > prev->first && isBlankChar( last[-1] ) ) --last;
+        prev->last = last;
+        prev = part;
+    }
+    return true;
+}
+
+/* Parse the elements of the top-level array of a part. */
+bool json_parsePart( jsonSplit_t* split, unsigned int i, jsonPool_t* pool ) {
+    jsonPart_t* const part = &split->part[i];
+    if ( !part->first ) return true;
+    json_t* const array = pool->init( pool );
+    if ( !array ) return false;
+    array->name = 0;
+    array->sibling = 0;
+    array->type = JSON_ARRAY;
+    array->flags = 0;
+    array->u.c.child = 0;
+    array->u.c.last_child = 0;
+    /* A part ends where its last element does, so neither the words read at
+       once nor the checks ahead reach the characters of the next part, which
+       another thread writes. The last part ends at the null character. */
+    jsonParser_t parser = { pool, 0, split->options, split->str + split->len, true, false };
+    if ( part->last ) {
+        parser.end = part->last;
+        parser.bounded = true;
+    }
+    json_t* open = array;
+    size_t const budget = part->last? (size_t)( part->last - part->first ): SIZE_MAX;
+    char* const ptr = objValue( part->first, &open, &parser, budget );
+    if ( !ptr ) return false;
+    if ( part->last? open != array: open || !isBlank( ptr ) ) return false;
+    part->array = array;
+    return true;
+}
+
+/* Join the elements of all parts in the top-level array. */
+json_t const* json_joinParts( jsonSplit_t* split ) {
+    json_t* const root = split->part[0].array;
+    if ( !root ) return 0;
+    unsigned int i;
+    /* The character after the last element of each part was left for now. */
+    for( i = 0; i < split->qty; ++i )
+        if ( split->part[i].array && split->part[i].last ) *split->part[i].last = '\0';
+    for( i = 1; i < split->qty; ++i ) {
+        json_t const* const array = split->part[i].array;
+        if ( !array ) {
+            if ( split->part[i].first ) return 0;
+            continue;
+        }
+        if ( !array->u.c.child ) continue;
+        if ( root->u.c.child ) {
+            root->u.c.last_child->sibling = array->u.c.child;
+            root->u.c.last_child->flags &= ~lastFlag;
+        }
+        else root->u.c.child = array->u.c.child;
+        root->u.c.last_child = array->u.c.last_child;
+        root->u.c.last_child->sibling = root;
+    }
+    return root;
+}
+
+/** Split the path of a predicate in names.
+  * @param pred The predicate.
+  * @param path Names separated by '.'.
+  * @return true if success. */
+static bool setPath( jsonPredicate_t* pred, char const* path ) {
+    unsigned int depth = 0;
+    for(;;) {
+        char const* const dot = strchr( path, '.' );
+        size_t const len = dot? (size_t)( dot - path ): strlen( path );
+        if ( !len || depth == JSON_MAXPATH ) return false;
+        pred->name[ depth ] = path;
+        pred->len[ depth ] = len;
+        ++depth;
+        if ( !dot ) break;
+        path = dot + 1;
+    }
+    pred->depth = depth;
+    return true;
+}
+
+/* Build a condition on a text property of records. */
+bool json_initTextPredicate( jsonPredicate_t* pred, char const* path, jsonCondition_t condition, char const* text ) {
+    pred->condition = condition;
+    pred->text = text;
+    pred->textlen = strlen( text );
+    pred->min = 0;
+    pred->max = 0;
+    return setPath( pred, path );
+}
+
+/* Build a condition on a number property of records. */
+bool json_initRangePredicate( jsonPredicate_t* pred, char const* path, double min, double max ) {
+    pred->condition = JSON_RANGE;
+    pred->text = 0;
+    pred->textlen = 0;
+    pred->min = min;
+    pred->max = max;
+    return setPath( pred, path );
+}
+
+/** Skip the white spaces of a string that is not null-terminated.
+  * @param ptr Pointer to the first character.
+  * @param end Pointer to the character after the string.
+  * @return Pointer to the first non white space or end. */
+static char const* skipBlanks( char const* ptr, char const* end ) {
+    while( ptr < end && isBlankChar( *ptr ) ) ++ptr;
+    return ptr;
+}
+
+/** Search a name between quotes in a string. The first and the last character
+  * of the name are compared at eight positions at a time and the rest of it
+  * only where both match.
+  * @param str Pointer to the first character.
+  * @param end Pointer to the character after the string.
+  * @param name The name, not null-terminated.
+  * @param len Length of the name. At least one.
+  * @return Pointer to the quote before the first match or null pointer if none. */
+static char const* findName( char const* str, char const* end, char const* name, size_t len ) {
+    uint64_t const ones = 0x0101010101010101ull;
+    uint64_t const first = ones * (unsigned char)name[0];
+    uint64_t const last = ones * (unsigned char)name[ len - 1 ];
+    char const* ptr = str;
+    while( (size_t)( end - ptr ) >= len + 2 ) {
+        if ( (size_t)( end - ptr ) >= len + 9 ) {
+            uint64_t mask = zeroBytes8( load8( ptr + 1 ) ^ first ) & zeroBytes8( load8( ptr + len ) ^ last );
+            while( mask ) {
+                char const* const match = ptr + firstByte( mask );
+                if ( match[0] == '\"' && match[ len + 1 ] == '\"' && !memcmp( match + 1, name, len ) )
+                    return match;
+                mask &= mask - 1;
+            }
+            ptr += 8;
+            continue;
+        }
+        if ( ptr[0] == '\"' && ptr[ len + 1 ] == '\"' && !memcmp( ptr + 1, name, len ) )
+            return ptr;
+        ++ptr;
+    }
+    return 0;
+}
+
+/** Advance the state of the scan of an object up to a character. Eight
+  * characters without backslashes are scanned at a time unless the object
+  * could be closed among them.
+  * @param ptr Pointer to the next character to scan.
+  * @param end Pointer to the character where it stops.
+  * @param inString Whether ptr is in a string. It is updated.
+  * @param depth Depth at ptr, one in the object itself. It is updated.
+  * @retval Pointer to the character where it stopped. It is after end if the
+  *         last character scanned is a backslash.
+  * @retval Null pointer if the object is closed before end. */
+static char const* advance( char const* ptr, char const* end, bool* inString, long* depth ) {
+    uint64_t const ones = 0x0101010101010101ull;
+    unsigned int quotes = *inString;
+    long level = *depth;
+    for(;;) {
+        if ( end - ptr >= 8 ) {
+            uint64_t const word = load8( ptr );
+            if ( !zeroBytes8( word ^ ones * '\\' ) ) {
+                uint64_t const folded = word | ones * 0x20;
+                uint64_t parity = zeroBytes8( word ^ ones * '\"' ) >> 7;
+                parity ^= parity << 8;
+                parity ^= parity << 16;
+                parity ^= parity << 32;
+                uint64_t const odd = parity << 7;
+                uint64_t const outside = quotes? odd: ~odd & 0x8080808080808080ull;
+                uint64_t const opens = zeroBytes8( folded ^ ones * '{' ) & outside;
+                uint64_t const closes = zeroBytes8( folded ^ ones * '}' ) & outside;
+                long const closed = (long)countBytes( closes );
+                if ( level > closed ) {
+                    level += (long)countBytes( opens ) - closed;
+                    quotes ^= (unsigned int)( parity >> 56 );
+                    ptr += 8;
+                    continue;
+                }
+            }
+        }
+        if ( ptr >= end ) break;
+        char const ch = *ptr++;
+        if ( ch == '\\' ) ++ptr;
+        else if ( ch == '\"' ) quotes = !quotes;
+        else if ( quotes ) continue;
+        else if ( ch == '[' || ch == '{' ) ++level;
+        else if ( ch == ']' || ch == '}' ) {
+            if ( --level == 0 ) return 0;
+        }
+    }
+    *inString = quotes;
+    *depth = level;
+    return ptr;
+}
+
+/** Find the value of a property of an object in its raw bytes.
+  * @param obj Pointer to the '{' of the object.
+  * @param end Pointer to the character after the string.
+  * @param name Name of the property, not null-terminated.
+  * @param len Length of the name.
+  * @return Pointer to the first character of the value or null pointer if
+  *         the object has not a property with the name. */
+static char const* findKey( char const* obj, char const* end, char const* name, size_t len ) {
+    char const* ptr = obj + 1;
+    char const* from = ptr;
+    bool inString = false;
+    long depth = 1;
+    for(;;) {
+        char const* const match = findName( from, end, name, len );
+        if ( !match ) return 0;
+        ptr = advance( ptr, match, &inString, &depth );
+        if ( !ptr ) return 0;
+        from = match + 1;
+        /* The match is a string of the object itself, but it is a value
+           unless a colon is after it. */
+        if ( ptr != match || inString || depth != 1 ) continue;
+        char const* const colon = skipBlanks( match + len + 2, end );
+        if ( colon < end && *colon == ':' ) return skipBlanks( colon + 1, end );
+    }
+}
+
+/** Compare a text value in its raw bytes with the text of a predicate.
+  * The escape sequences are decoded on the way.
+  * @param ptr Pointer to the first character of the value.
+  * @param end Pointer to the character after the string.
+  * @param pred A JSON_EQUAL or JSON_PREFIX predicate.
+  * @return true if the condition is true. */
+static bool matchText( char const* ptr, char const* end, jsonPredicate_t const* pred ) {
+    if ( ptr >= end || *ptr != '\"' ) return false;
+    bool const prefix = pred->condition == JSON_PREFIX;
+    unsigned char const* text = (unsigned char const*)pred->text;
+    unsigned char const* const last = text + pred->textlen;
+    for( ++ptr; ptr < end; ++ptr ) {
+        if ( prefix && text == last ) return true;
+        unsigned char const ch = (unsigned char)*ptr;
+        if ( ch == '\"' ) return text == last;
+        if ( ch != '\\' ) {
+            if ( text == last || *text != ch ) return false;
+            ++text;
+            continue;
+        }
+        unsigned char const* const esc = (unsigned char const*)ptr + 1;
+        size_t const avail = (size_t)( end - ptr ) - 1;
+        unsigned char buf[4];
+        size_t qty = 1;
+        if ( avail && *esc == 'u' ) {
+            uint32_t point;
+            unsigned int const seq = unicodeEscape( esc, avail, &point );
+            if ( !seq ) return false;
+            qty = (size_t)( encodeUtf8( point, buf ) - buf ) + 1;
+            ptr += seq;
+        }
+        else {
+            char const decoded = avail? getEscape( (char)*esc ): '\0';
+            if ( decoded == '\0' ) return false;
+            buf[0] = (unsigned char)decoded;
+            ++ptr;
+        }
+        size_t const rest = (size_t)( last - text );
+        if ( rest < qty ) return prefix && !memcmp( text, buf, rest );
+        if ( memcmp( text, buf, qty ) ) return false;
+        text += qty;
+    }
+    return false;
+}
+
+/** Check whether a number value in its raw bytes is in the range of a predicate.
+  * The value must follow the grammar of the JSON numbers.
+  * @param ptr Pointer to the first character of the value.
+  * @param end Pointer to the character after the string.
+  * @param pred A JSON_RANGE predicate.
+  * @return true if the condition is true. */
+static bool matchRange( char const* ptr, char const* end, jsonPredicate_t const* pred ) {
+    if ( ptr >= end || !checkNumber( ptr, end ) ) return false;
+    char const* stop;
+    double const value = toReal( ptr, &stop );
+    return value >= pred->min && value <= pred->max;
+}
+
+/* Check conditions on properties of a record in its raw bytes. */
+bool json_matchRecord( char const* str, size_t len, jsonPredicate_t const preds[], unsigned int qty ) {
+    char const* const end = str + len;
+    char const* const root = skipBlanks( str, end );
+    if ( root >= end || *root != '{' ) return false;
+    unsigned int i;
+    for( i = 0; i < qty; ++i ) {
+        jsonPredicate_t const* const pred = &preds[i];
+        char const* value = root;
+        unsigned int j;
+        for( j = 0; j < pred->depth; ++j ) {
+            if ( value >= end || *value != '{' ) return false;
+            value = findKey( value, end, pred->name[j], pred->len[j] );
+            if ( !value ) return false;
+        }
+        bool const match = pred->condition == JSON_RANGE?
+            matchRange( value, end, pred ):
+            matchText( value, end, pred );
+        if ( !match ) return false;
+    }
+    return true;
 }
@@ -51,7 +51,8 @@ typedef enum {
     JSON_INTEGER, JSON_REAL, JSON_NULL
 } jsonType_t;
 
-/** Structure to handle JSON properties. */
+/** Structure to handle JSON properties. There is one per value of a document:
+  * 40 bytes on 64-bit targets. The names and values stay in the document. */
 typedef struct json_s {
     struct json_s* sibling;
     char const* name;
@@ -61,10 +62,20 @@ typedef struct json_s {
             struct json_s* child;
             struct json_s* last_child;
         } c;
+        struct {
+            struct json_s* child;
+            void const* data;
+        } a;
     } u;
     jsonType_t type;
+    unsigned int flags;
 } json_t;
 
+/** Bit of the flags of the last property of an object or an array. Its sibling
+  * pointer is not null but the object or the array, so that the trees can be
+  * walked without a stack. See json_getSibling(). */
+#define JSON_LASTCHILD 0x10u
+
 /** Parse a string to get a json.
   * @param str String pointer with a JSON object. It will be modified.
   * @param mem Array of json properties to allocate.
@@ -72,7 +83,7 @@ typedef struct json_s {
   * @retval Null pointer if any was wrong in the parse process.
   * @retval If the parser process was successfully a valid handler of a json.
   *         This property is always unnamed and its type is JSON_OBJ. */
-json_t const* json_create( char* str, json_t mem[], unsigned int qty );
+json_t const* json_create( char* str, json_t mem[], size_t qty );
 
 /** Get the name of a json property.
   * @param json A valid handler of a json property.
@@ -102,7 +113,7 @@ static inline jsonType_t json_getType( json_t const* json ) {
   * @retval The handler of the next sibling if found.
   * @retval Null pointer if the json property is the last one. */
 static inline json_t const* json_getSibling( json_t const* json ) {
-    return json->sibling;
+    return ( json->flags & JSON_LASTCHILD )? 0: json->sibling;
 }
 
 /** Search a property by its name in a JSON object.
@@ -112,6 +123,15 @@ static inline json_t const* json_getSibling( json_t const* json ) {
   * @retval Null pointer if not found. */
 json_t const* json_getProperty( json_t const* obj, char const* property );
 
+/** Search a property by a name of known length in a JSON object. The name does
+  * not need to be null-terminated. The index of JSON_SORT_KEYS is used too.
+  * @param obj A valid handler of a json object. Its type must be JSON_OBJ.
+  * @param property The name of property to get.
+  * @param len The length of the name.
+  * @retval The handler of the json property if found.
+  * @retval Null pointer if not found. */
+json_t const* json_getPropertyLen( json_t const* obj, char const* property, size_t len );
+
 
 /** Search a property by its name in a JSON object and return its value.
   * @param obj A valid handler of a json object. Its type must be JSON_OBJ.
@@ -120,6 +140,100 @@ json_t const* json_getProperty( json_t const* obj, char const* property );
   * @retval Null pointer if not found or it is an array or an object. */
 char const* json_getPropertyValue( json_t const* obj, char const* property );
 
+/** Structure to search the properties of an object in the order they are
+  * usually written. See json_getCursorProperty(). */
+typedef struct jsonCursor_s {
+    json_t const* obj;  /**< The object to search in.                  */
+    json_t const* next; /**< The property after the last one found.    */
+} jsonCursor_t;
+
+/** Start a cursor to search the properties of a JSON object.
+  * @param cursor The cursor.
+  * @param obj A valid handler of a json object. Its type must be JSON_OBJ. */
+static inline void json_initCursor( jsonCursor_t* cursor, json_t const* obj ) {
+    cursor->obj  = obj;
+    cursor->next = obj->u.c.child;
+}
+
+/** Search a property by its name in a JSON object starting after the last one
+  * found with the cursor, then from the first one. Reading the properties
+  * in the order of the document takes one string comparison for each one.
+  * With repeated names the one found may not be the first of the object.
+  * @param cursor A cursor started with json_initCursor().
+  * @param property The name of property to get.
+  * @retval The handler of the json property if found.
+  * @retval Null pointer if not found. */
+json_t const* json_getCursorProperty( jsonCursor_t* cursor, char const* property );
+
+#ifndef JSON_MAXLOOKUP
+/** Maximum number of names of a jsonLookup_t. It must be less than 256. */
+#define JSON_MAXLOOKUP 32
+#endif
+
+/** Structure to handle a set of property names to search together.
+  * It is built once with json_initLookup() and used by json_getProperties(). */
+typedef struct jsonLookup_s {
+    char const* const* keys;  /**< Names to search.                             */
+    unsigned int qty;         /**< Number of names.                             */
+    uint32_t seed;            /**< Seed of the perfect hash, zero if not found. */
+    size_t len[ JSON_MAXLOOKUP ];             /**< Lengths of the names.        */
+    unsigned char slot[ 4 * JSON_MAXLOOKUP ]; /**< Position plus one of the name
+                                                   of each hash, zero if none.  */
+} jsonLookup_t;
+
+/** Build a set of property names to search together. A perfect hash of the
+  * length and of some characters of the names is looked for, so each property
+  * of an object is compared with one name at most. If there is not any, for
+  * instance because a name is repeated, every name is compared instead.
+  * @param lookup The set to build.
+  * @param keys Array of names. It must outlive the set.
+  * @param qty Number of names.
+  * @retval true if success.
+  * @retval false if there are more than JSON_MAXLOOKUP names. */
+bool json_initLookup( jsonLookup_t* lookup, char const* const keys[], unsigned int qty );
+
+/** Search several properties by their names in a JSON object in one pass over
+  * its properties. It stops as soon as every name is found.
+  * @param obj A valid handler of a json object. Its type must be JSON_OBJ.
+  * @param lookup The set of names built with json_initLookup().
+  * @param out Array where the handler of the first property with each name is
+  *            written, in the order of the names. Null pointer if not found.
+  * @return The number of names found. */
+unsigned int json_getProperties( json_t const* obj, jsonLookup_t const* lookup, json_t const* out[] );
+
+/** Structure to describe a column of values to extract from an array of objects.
+  * See json_extractColumns(). */
+typedef struct jsonColumn_s {
+    char const* name; /**< Name of the property.                                     */
+    jsonType_t type;  /**< Type of the values: JSON_INTEGER (int64_t), JSON_REAL
+                           (double), JSON_BOOLEAN (bool) or JSON_TEXT (char const*). */
+    void* out;        /**< Array where the values are written.                       */
+    unsigned int pos; /**< Position of the property in the last object. Set it to zero
+                           the first time, it is updated on every object.           */
+} jsonColumn_t;
+
+/** Extract the values of properties from every object of an array in one pass.
+  * The position of each property in the previous object is tried first, so the
+  * properties are found with one string comparison when the objects share a layout.
+  * A JSON_REAL column also accepts JSON_INTEGER values.
+  * @param array A valid handler of a json array of objects.
+  * @param cols Array of columns.
+  * @param qtycols Number of elements of cols.
+  * @param qty Maximum number of values to write in each column.
+  * @return The number of objects extracted. It stops at the first element
+  *         that is not an object, misses a property or has another type. */
+size_t json_extractColumns( json_t const* array, jsonColumn_t cols[], unsigned int qtycols, size_t qty );
+
+/** Extract the value of a property from every object of an array.
+  * See json_extractColumns().
+  * @param array A valid handler of a json array of objects.
+  * @param property The name of the property.
+  * @param type The type of the values. See jsonColumn_t.
+  * @param out Array where the values are written.
+  * @param qty Number of elements of out.
+  * @return The number of objects extracted. */
+size_t json_extractColumn( json_t const* array, char const* property, jsonType_t type, void* out, size_t qty );
+
 /** Get the first property of a JSON object or array.
   * @param json A valid handler of a json property.
   *             Its type must be JSON_OBJ or JSON_ARRAY.
@@ -139,16 +253,12 @@ static inline bool json_getBoolean( json_t const* property ) {
 /** Get the value of a json integer property.
   * @param property A valid handler of a json object. Its type must be JSON_INTEGER.
   * @return The value stdint. */
-static inline int64_t json_getInteger( json_t const* property ) {
-  return strtoll( property->u.value,(char**)NULL, 10);
-}
+int64_t json_getInteger( json_t const* property );
 
 /** Get the value of a json real property.
   * @param property A valid handler of a json object. Its type must be JSON_REAL.
   * @return The value. */
-static inline double json_getReal( json_t const* property ) {
-  return strtod( property->u.value,(char**)NULL );
-}
+double json_getReal( json_t const* property );
 
 
 
@@ -167,6 +277,668 @@ struct jsonPool_s {
   *         This property is always unnamed and its type is JSON_OBJ. */
 json_t const* json_createWithPool( char* str, jsonPool_t* pool );
 
+/** Parse a string that is not null-terminated to get a json, f.i. a frame
+  * received from a network, without copying it to append a null character.
+  * No character is read beyond the length.
+  * @param str Pointer to the first character of the JSON object. It will be modified.
+  * @param len Number of characters.
+  * @param pool Custom json pool pointer.
+  * @retval Null pointer if any was wrong in the parse process, the characters
+  *         have a null one or the last one that is not a white space is not
+  *         the end of an object or an array.
+  * @retval If the parser process was successfully a valid handler of a json. */
+json_t const* json_createN( char* str, size_t len, jsonPool_t* pool );
+
+/** Parse the next JSON document of a string that holds many of them,
+  * f.i. "{...}{...}[...]". The json is created with the init function
+  * of the pool, so the previous json could be overwritten.
+  * @param str String pointer with JSON documents. It will be modified.
+  * @param pool Custom json pool pointer.
+  * @param end Pointer where it is written the pointer to the first character
+  *            after the document if success, the pointer to the null character
+  *            if there are only white spaces and null pointer otherwise.
+  * @retval Null pointer if any was wrong in the parse process.
+  * @retval If the parser process was successfully a valid handler of a json. */
+json_t const* json_createNext( char* str, jsonPool_t* pool, char** end );
+
+/** Parse consecutive JSON documents of a string in one call.
+  * The first json is created with the init function of the pool and the rest
+  * with the alloc function, so all of them remain valid.
+  * @param str String pointer with JSON documents. It will be modified.
+  * @param pool Custom json pool pointer.
+  * @param roots Array where the handlers of the jsons are written.
+  * @param qty Number of elements of roots.
+  * @param end Pointer where it is written the pointer to the first character
+  *            after the last parsed document, the pointer to the null character
+  *            if there are only white spaces left and null pointer if a
+  *            document is malformed.
+  * @return The number of parsed documents. */
+size_t json_createBatch( char* str, jsonPool_t* pool, json_t const* roots[], size_t qty, char** end );
+
+/** Check whether a string would be parsed successfully without parsing it.
+  * It applies the same rules as json_create() but nothing is allocated and
+  * the string is not modified. The scan stops at the first null character.
+  * The nesting level is limited to JSON_MAXDEPTH, 1024 by default, which can
+  * be defined when tiny-json.c is compiled.
+  * @param str Pointer to the first character of the string.
+  * @param len Number of characters of the string.
+  * @return true if the string holds a valid json. */
+bool json_validate( char const* str, size_t len );
+
+/** Remove the white spaces of a JSON string that are not inside texts.
+  * The texts are kept as they are, including their escape sequences.
+  * @param str String pointer with a JSON. It is modified in place.
+  * @return The new length of the string. */
+size_t json_minify( char* str );
+
+/** Structure to handle an entry of a table of interned property names. */
+typedef struct jsonKey_s {
+    char const* name; /**< Canonical name or null pointer if the entry is free. */
+    uint32_t hash;    /**< Hash of the name. See json_hashKey(). */
+} jsonKey_t;
+
+/** Structure to handle a table of interned property names.
+  * The same table can be shared by many parse processes. Equal property names
+  * get the same canonical pointer so that they can be compared by address.
+  * The canonical names are copied to an own buffer, so they outlive the
+  * JSON strings that were parsed. Initialize it with json_initKeys(). */
+typedef struct jsonKeys_s {
+    jsonKey_t* mem;   /**< Array of entries for open addressing.  */
+    unsigned int qty; /**< Length of the array of entries.        */
+    char* buf;        /**< Storage for the canonical names.       */
+    size_t size;      /**< Length of the storage.                 */
+    size_t used;      /**< Number of bytes of the storage in use. */
+} jsonKeys_t;
+
+/** Initialize an empty table of interned property names.
+  * @param keys The table to be initialized.
+  * @param mem Array of entries. At least one entry is always left free.
+  * @param qty Number of elements of mem.
+  * @param buf Storage for the canonical names.
+  * @param size Length of buf. */
+void json_initKeys( jsonKeys_t* keys, jsonKey_t mem[], unsigned int qty, char buf[], size_t size );
+
+/** Get the hash of a property name used by the tables of interned names.
+  * It is the 32-bit FNV-1a hash of the characters of the name.
+  * @param name Pointer to null-terminated string.
+  * @return The hash value. */
+uint32_t json_hashKey( char const* name );
+
+/** Search a name in a table of interned property names.
+  * @param keys The table.
+  * @param name Pointer to null-terminated string.
+  * @param hash The hash of the name. See json_hashKey().
+  * @retval The canonical pointer of the name if found.
+  * @retval Null pointer if the name has not been interned. */
+char const* json_findKey( jsonKeys_t const* keys, char const* name, uint32_t hash );
+
+/** Add a name to a table of interned property names if it is not already there.
+  * @param keys The table.
+  * @param name Pointer to null-terminated string.
+  * @retval The canonical pointer of the name.
+  * @retval Null pointer if the table or its storage is full. */
+char const* json_internKey( jsonKeys_t* keys, char const* name );
+
+/** Parse a string to get a json and intern the names of its properties.
+  * The name of every property points to a canonical name of the table.
+  * @param str String pointer with a JSON object. It will be modified.
+  * @param pool Custom json pool pointer.
+  * @param keys Table of interned property names.
+  * @retval Null pointer if any was wrong in the parse process or the table is full.
+  * @retval If the parser process was successfully a valid handler of a json.
+  *         This property is always unnamed and its type is JSON_OBJ. */
+json_t const* json_createWithKeys( char* str, jsonPool_t* pool, jsonKeys_t* keys );
+
+/** Codes of the optional modes of a parse process. They can be combined. */
+typedef enum {
+    /** Arrays made only of numbers are stored as packed vectors of int64_t,
+      * or of double if any of them is real, instead of a list of json
+      * properties. They take 8 bytes per value from consecutive json properties
+      * of the pool instead of one json property per value. The characters
+      * of an array are checked before any json property is taken, so an array
+      * that also has other values, like [1,2,"x"], takes as many as without
+      * this option. If the pool does not provide consecutive json properties
+      * the array is not packed, and the ones it took before it found that are
+      * not returned to the pool.
+      * A packed array has no children, use json_getArrayData() to get its values. */
+    JSON_PACK_NUMBERS = 1 << 0,
+    /** The properties of every object are indexed in an array sorted by name,
+      * so json_getProperty() finds them with a binary search. The index takes
+      * one pointer per property plus its length from consecutive json
+      * properties of the pool. If the pool does not provide consecutive json
+      * properties the object is not indexed. The children of the object are
+      * kept in the order of the document. */
+    JSON_SORT_KEYS = 1 << 1,
+    /** Objects with repeated property names are rejected. The repeated names
+      * are found while building the index, so it implies JSON_SORT_KEYS. */
+    JSON_UNIQUE_KEYS = 1 << 2,
+    /** The escape sequences of the texts are checked but not decoded, so the
+      * texts that are never read cost only a scan. json_getValue() gets a text
+      * as it is in the document, ready to be forwarded, and json_getText()
+      * decodes it the first time. The names of the properties are decoded. */
+    JSON_DEFER_ESCAPES = 1 << 3
+} jsonOption_t;
+
+/** Parse a string to get a json with optional modes.
+  * @param str String pointer with a JSON object. It will be modified.
+  * @param pool Custom json pool pointer.
+  * @param keys Table of interned property names or null pointer.
+  *             See json_createWithKeys().
+  * @param options Combination of codes of jsonOption_t.
+  * @retval Null pointer if any was wrong in the parse process.
+  * @retval If the parser process was successfully a valid handler of a json. */
+json_t const* json_createWithOptions( char* str, jsonPool_t* pool, jsonKeys_t* keys, unsigned int options );
+
+/** Get the value of a json text property with its escape sequences decoded.
+  * If they were deferred with JSON_DEFER_ESCAPES, the first call decodes the
+  * text in its place of the string, so it must not be called concurrently
+  * for the same property.
+  * @param json A valid handler of a json property. Its type must be JSON_TEXT.
+  * @return Pointer to null-terminated string with the text. */
+char const* json_getText( json_t const* json );
+
+/** Check whether the value of a json text property has escape sequences that
+  * are not decoded yet. See JSON_DEFER_ESCAPES.
+  * @param json A valid handler of a json property.
+  * @return true if json_getValue() gets the text as it is in the document. */
+bool json_hasEscapes( json_t const* json );
+
+/** Get the length of the value of a json text property. It is stored when the
+  * document is parsed, so the value is not read. Its escape sequences are
+  * decoded first if they were deferred. See JSON_DEFER_ESCAPES.
+  * @param json A valid handler of a json text property.
+  * @return The number of characters of the value. */
+size_t json_getTextLength( json_t const* json );
+
+/** Structure to handle the state of a parse process. Its members are private. */
+typedef struct jsonParser_s {
+    jsonPool_t* pool; /**< Pool to create the json properties.       */
+    jsonKeys_t* keys; /**< Table to intern the names or null pointer. */
+    unsigned int options; /**< Optional modes. See jsonOption_t.    */
+    char const* end;  /**< The characters before it are known to be non-null. */
+    bool last;        /**< The end pointer points to the null character.      */
+    bool bounded;     /**< The string is not null-terminated, it ends at the end pointer. */
+} jsonParser_t;
+
+/** Structure to handle a parse process in steps. See json_parseStep(). */
+typedef struct jsonStep_s {
+    jsonParser_t parser; /**< The state of the parse process. Private.         */
+    char* ptr;           /**< Next character to parse. Private.                */
+    json_t* open;        /**< Innermost object or array still open. Private.   */
+    json_t const* root;  /**< The root json. It is complete after JSON_STEP_DONE. */
+} jsonStep_t;
+
+/** Codes of the result of a step of a parse process. */
+typedef enum {
+    JSON_STEP_MORE,  /**< There are characters left to parse.             */
+    JSON_STEP_DONE,  /**< The json is complete. See jsonStep_t.root.      */
+    JSON_STEP_ERROR  /**< Any was wrong in the parse process.             */
+} jsonStepStatus_t;
+
+/** Start a parse process in steps. Nothing is parsed until json_parseStep().
+  * @param step The state of the parse process.
+  * @param str String pointer with a JSON object. It will be modified and it
+  *            must outlive the parse process.
+  * @param pool Custom json pool pointer.
+  * @param keys Table of interned property names or null pointer.
+  * @param options Combination of codes of jsonOption_t. */
+void json_initStep( jsonStep_t* step, char* str, jsonPool_t* pool, jsonKeys_t* keys, unsigned int options );
+
+/** Continue a parse process for a bounded amount of work, so that a long
+  * document can be parsed between other tasks. It stops at the end of the first
+  * value after parsing budget characters, at least one value per step. A packed
+  * array of numbers is parsed in one step. The json is the same that
+  * json_createWithOptions() gets.
+  * @param step The state of a parse process started with json_initStep().
+  * @param budget Number of characters to parse.
+  * @retval JSON_STEP_MORE if it must be called again.
+  * @retval JSON_STEP_DONE if the json is complete. The root is in step->root.
+  * @retval JSON_STEP_ERROR if any was wrong in the parse process. */
+jsonStepStatus_t json_parseStep( jsonStep_t* step, size_t budget );
+
+/** @name Building blocks of the parsers generated by json-codegen.
+  * A generated parser reads the values of a known shape straight into a
+  * structure and leaves the values it does not know to json_scanValue().
+  * Every function gets a pointer to the first character of the value and
+  * returns a pointer to the character after it, or null pointer if any
+  * was wrong. The string is modified as in json_create(). See codegen/.
+  * @{ */
+
+/** Start a parse process of a generated parser.
+  * @param parser The state of the parse process.
+  * @param str String pointer with a JSON object. It will be modified.
+  * @param pool Pool for the values parsed with json_scanValue(). */
+void json_initScan( jsonParser_t* parser, char* str, jsonPool_t* pool );
+
+/** Skip white spaces. It returns null pointer at the null character. */
+char* json_scanBlank( char* str );
+
+/** Parse the name of a property and the colon after it. The name is
+  * decoded in place, from str + 1, and null-terminated.
+  * @param len Pointer where the length of the name is written. */
+char* json_scanName( char* str, jsonParser_t* parser, size_t* len );
+
+/** Parse a text. It is decoded in place and null-terminated.
+  * @param text Pointer where the pointer to the text is written. */
+char* json_scanText( char* str, jsonParser_t* parser, char const** text );
+
+/** Parse an integer. Real numbers are rejected. */
+char* json_scanInteger( char* str, jsonParser_t* parser, int64_t* value );
+
+/** Parse a number, either real or integer. */
+char* json_scanReal( char* str, jsonParser_t* parser, double* value );
+
+/** Parse true or false. */
+char* json_scanBoolean( char* str, bool* value );
+
+/** Parse any value with the generic parser. The pool of the parse process
+  * is initialized for each value, so the value is valid until the next one.
+  * @param value Pointer where the handler of the value is written. */
+char* json_scanValue( char* str, jsonParser_t* parser, json_t const** value );
+
+/** @} */
+
+/** Get the type of the values of a packed array. See JSON_PACK_NUMBERS.
+  * @param json A valid handler of a json property.
+  * @retval JSON_INTEGER if the values are int64_t.
+  * @retval JSON_REAL if the values are double.
+  * @retval JSON_ARRAY if it is an array that is not packed.
+  * @retval The type of the json if it is not an array. */
+jsonType_t json_getArrayType( json_t const* json );
+
+/** Get the number of values of a packed array. See JSON_PACK_NUMBERS.
+  * @param json A valid handler of a json property.
+  * @return The number of values or zero if it is not a packed array. */
+size_t json_getArrayLength( json_t const* json );
+
+/** Get the values of a packed array. See JSON_PACK_NUMBERS.
+  * @param json A valid handler of a json property.
+  * @retval Pointer to an array of int64_t or double. See json_getArrayType().
+  * @retval Null pointer if it is not a packed array. */
+void const* json_getArrayData( json_t const* json );
+
+/** Search a property by its canonical name in a JSON object.
+  * The names are compared by address so the json must be created
+  * with json_createWithKeys() and the same table.
+  * @param obj A valid handler of a json object. Its type must be JSON_OBJ.
+  * @param key Canonical name returned by json_internKey() or json_findKey().
+  * @retval The handler of the json property if found.
+  * @retval Null pointer if not found. */
+static inline json_t const* json_getInternedProperty( json_t const* obj, char const* key ) {
+    json_t const* sibling;
+    for( sibling = obj->u.c.child; sibling; sibling = json_getSibling( sibling ) )
+        if ( sibling->name == key )
+            return sibling;
+    return 0;
+}
+
+/** Get a hash of the content of a json property. The order of the properties
+  * of objects does not matter and the numbers are hashed by value, so 1, 1.0
+  * and 10e-1 have the same hash. Two properties with the same content according
+  * to json_equal() have the same hash.
+  * @param json A valid handler of a json property.
+  * @return The hash. It is the same only within the same build. */
+uint32_t json_hash( json_t const* json );
+
+/** Check whether two json properties have the same content. The properties of
+  * objects are matched by name in any order, with their own names ignored,
+  * and the numbers are compared by value. With repeated names in an object the
+  * result may depend on their order.
+  * @param a A valid handler of a json property.
+  * @param b A valid handler of a json property.
+  * @retval true if they have the same content.
+  * @retval false if not. */
+bool json_equal( json_t const* a, json_t const* b );
+
+/** Copy a json property and all its children to another pool and buffer.
+  * The copy is compact: its json properties are allocated one after another
+  * and its names, values and raw data are packed in one buffer, so the string
+  * that was parsed, its pool and its table of interned names can be released.
+  * The escape sequences that were deferred stay deferred in the copy.
+  * @param json A valid handler of a json property.
+  * @param pool The pool of the copy. It is initialized as in a parse process.
+  * @param buf Buffer for the names, the values and the raw data of the copy.
+  * @param size Length of the buffer. See json_cloneSize().
+  * @retval The handler of the copy if success.
+  * @retval Null pointer if the pool or the buffer is full. */
+json_t const* json_clone( json_t const* json, jsonPool_t* pool, char* buf, size_t size );
+
+/** Get the resources needed to copy a json property with json_clone().
+  * @param json A valid handler of a json property.
+  * @param qty Destination of the number of json properties of the copy.
+  * @param size Destination of the length of the buffer. It includes the
+  *        worst alignment of the raw data so it can be a few bytes larger
+  *        than the space actually used.
+  * @return true. */
+bool json_cloneSize( json_t const* json, size_t* qty, size_t* size );
+
+/** Entry of a jsonIndex_t. */
+typedef struct jsonIndexEntry_s {
+    json_t const* element; /**< Object of the array, null if the entry is free. */
+    json_t const* key;     /**< Its property with the name of the index.        */
+    uint32_t hash;         /**< Hash of the value of that property.             */
+} jsonIndexEntry_t;
+
+/** Hash table of the objects of an array by the value of one of their
+  * properties. It is built with json_indexArrayBy(). */
+typedef struct jsonIndex_s {
+    jsonIndexEntry_t* entries; /**< Open addressing table.                  */
+    size_t mask;               /**< Number of entries minus one.            */
+    size_t qty;                /**< Number of objects indexed.              */
+} jsonIndex_t;
+
+/** Build a hash table of the objects of an array by the value of a property,
+  * f.i. the "id" of the rows of a catalog, in one pass over the array. Texts
+  * and numbers can be keys, and the numbers are compared by value. The objects
+  * without that property or with another type of value are not indexed. With
+  * repeated values the first object is indexed.
+  * @param index The index to build.
+  * @param array A valid handler of a json array.
+  * @param key The name of the property.
+  * @param pool Pool where the table is allocated. It has twice the entries
+  *        of the length of the array, rounded up to a power of two, and needs
+  *        consecutive json properties, like the ones of json_create().
+  * @retval true if success.
+  * @retval false if it is not an array of json properties or the pool is full. */
+bool json_indexArrayBy( jsonIndex_t* index, json_t const* array, char const* key, jsonPool_t* pool );
+
+/** Search an object in a keyed index by the value of a json property, f.i.
+  * a reference to a row of a catalog in another document.
+  * @param index An index built by json_indexArrayBy().
+  * @param value A valid handler of a json property.
+  * @retval The handler of the object if found.
+  * @retval Null pointer if not found. */
+json_t const* json_getIndexed( jsonIndex_t const* index, json_t const* value );
+
+/** Search an object in a keyed index by a text.
+  * @param index An index built by json_indexArrayBy().
+  * @param value The text. It is compared with the decoded texts.
+  * @retval The handler of the object if found.
+  * @retval Null pointer if not found. */
+json_t const* json_getIndexedText( jsonIndex_t const* index, char const* value );
+
+/** Search an object in a keyed index by an integer.
+  * @param index An index built by json_indexArrayBy().
+  * @param value The integer.
+  * @retval The handler of the object if found.
+  * @retval Null pointer if not found. */
+json_t const* json_getIndexedInteger( jsonIndex_t const* index, int64_t value );
+
+/** Side buffer for the strings and pool for the json properties created
+  * when a parsed json is modified. See json_initEdit(). */
+typedef struct jsonEdit_s {
+    jsonPool_t* pool; /**< Pool of the new json properties. */
+    char* buf;        /**< Buffer for the new names and values. */
+    size_t size;      /**< Length of the buffer. */
+    size_t len;       /**< Number of bytes used. */
+} jsonEdit_t;
+
+/** Start an edit of a parsed json.
+  * @param edit The edit.
+  * @param pool Pool for the new json properties. It can be the one of the parse
+  *        process, then it must not be initialized again while editing.
+  * @param buf Buffer for the new names and values. It must outlive the json.
+  * @param size Length of the buffer. */
+static inline void json_initEdit( jsonEdit_t* edit, jsonPool_t* pool, char* buf, size_t size ) {
+    edit->pool = pool;
+    edit->buf  = buf;
+    edit->size = size;
+    edit->len  = 0;
+}
+
+/** Change the value of a json property to null. Like the other setters,
+  * the previous value and children of the property are dropped. The setters,
+  * json_insert(), json_remove() and json_rename() modify the parsed json in
+  * place, so cursors, lookups and keyed indexes built over it are invalidated.
+  * @param json A valid handler of a json property. */
+void json_setNull( json_t const* json );
+
+/** Change the value of a json property to a boolean.
+  * @param json A valid handler of a json property.
+  * @param value The new value. */
+void json_setBoolean( json_t const* json, bool value );
+
+/** Change the value of a json property to an integer.
+  * @param edit The edit where the value is stored.
+  * @param json A valid handler of a json property.
+  * @param value The new value.
+  * @retval true if success.
+  * @retval false if the buffer of the edit is full. */
+bool json_setInteger( jsonEdit_t* edit, json_t const* json, int64_t value );
+
+/** Change the value of a json property to a real number.
+  * @param edit The edit where the value is stored.
+  * @param json A valid handler of a json property.
+  * @param value The new value.
+  * @retval true if success.
+  * @retval false if the value is not finite or the buffer of the edit is full. */
+bool json_setReal( jsonEdit_t* edit, json_t const* json, double value );
+
+/** Change the value of a json property to a text.
+  * @param edit The edit where the text is copied.
+  * @param json A valid handler of a json property.
+  * @param text The new value, without escape sequences.
+  * @retval true if success.
+  * @retval false if the buffer of the edit is full. */
+bool json_setText( jsonEdit_t* edit, json_t const* json, char const* text );
+
+/** Change the value of a json property to an empty object or array.
+  * @param json A valid handler of a json property.
+  * @param type JSON_OBJ or JSON_ARRAY.
+  * @retval true if success.
+  * @retval false if the type is not an object or an array. */
+bool json_setEmpty( json_t const* json, jsonType_t type );
+
+/** Insert a property with a null value in an object or an array.
+  * Its value can be changed then with the setters.
+  * @param edit The edit where the property and its name are allocated.
+  * @param parent A valid handler of a json object or array. The arrays packed
+  *        with JSON_PACK_NUMBERS can not be modified.
+  * @param before The child before which the property is inserted, or null
+  *        pointer to append it at the end.
+  * @param name The name of the property in an object, or null pointer in an array.
+  * @retval The handler of the new property if success.
+  * @retval Null pointer if the pool or the buffer is full or the arguments
+  *         are not valid. */
+json_t const* json_insert( jsonEdit_t* edit, json_t const* parent, json_t const* before, char const* name );
+
+/** Remove a property from an object or an array.
+  * @param parent A valid handler of a json object or array.
+  * @param property The child to remove.
+  * @retval true if success.
+  * @retval false if it is not a child of the parent or the parent is packed. */
+bool json_remove( json_t const* parent, json_t const* property );
+
+/** Change the name of a property of an object. The new name is not interned.
+  * @param edit The edit where the name is copied.
+  * @param obj A valid handler of a json object.
+  * @param property The child to rename.
+  * @param name The new name.
+  * @retval true if success.
+  * @retval false if it is not a child of the object or the buffer of the
+  *         edit is full. */
+bool json_rename( jsonEdit_t* edit, json_t const* obj, json_t const* property, char const* name );
+
+/** Write a json property and all its children as a compact JSON string.
+  * The numbers and the texts whose escape sequences are still deferred are
+  * copied as they were written in the original document.
+  * @param json A valid handler of a json property. Its own name is not written.
+  * @param buf Destination buffer. The string is always null-terminated if the
+  *        size is not zero, and it is truncated if it does not fit.
+  * @param size Length of the buffer.
+  * @return The length of the whole string without the null character, or zero
+  *         if a packed array has a real that overflowed, like 1e400. */
+size_t json_serialize( json_t const* json, char* buf, size_t size );
+
+/** Decode in place the value of a json text property written in hexadecimal,
+  * in upper or lower case. Eight digits are decoded at a time. The bytes
+  * overwrite the value, so the property can not be used as a text any more.
+  * @param json A valid handler of a json text property.
+  * @param size Pointer where the number of bytes is written.
+  * @retval Pointer to the bytes if success.
+  * @retval Null pointer if the value is not hexadecimal. It may be modified. */
+void const* json_decodeHex( json_t const* json, size_t* size );
+
+/** Decode in place the value of a json text property written in base64 with
+  * the standard alphabet, with or without padding. Eight characters are
+  * decoded at a time. The bytes overwrite the value, so the property can not
+  * be used as a text any more.
+  * @param json A valid handler of a json text property.
+  * @param size Pointer where the number of bytes is written.
+  * @retval Pointer to the bytes if success.
+  * @retval Null pointer if the value is not base64. It may be modified. */
+void const* json_decodeBase64( json_t const* json, size_t* size );
+
+/** Get the value of a json text property with a RFC 3339 timestamp, like
+  * "2024-03-01T12:30:00.250+01:00", as nanoseconds since 1970-01-01T00:00:00Z.
+  * The digits beyond nanoseconds are ignored and a leap second is taken as the
+  * first second of the next minute.
+  * @param json A valid handler of a json text property.
+  * @param ns Pointer where the number of nanoseconds is written.
+  * @retval true if success.
+  * @retval false if the value is not a timestamp or it is out of the range
+  *         of the nanoseconds, from 1677 to 2262. */
+bool json_getTimestamp( json_t const* json, int64_t* ns );
+
+#ifndef JSON_MAXPARTS
+/** Maximum number of parts of a top-level array parsed in parallel. */
+#define JSON_MAXPARTS 64
+#endif
+
+/** Part of a string with a top-level array parsed by one thread.
+  * See json_splitArray(). */
+typedef struct jsonPart_s {
+    char* begin;    /**< First character of the part.                          */
+    char* end;      /**< Character after the part.                             */
+    char* comma;    /**< First comma between elements in the part or null.     */
+    char* first;    /**< First element to parse with the part or null if none. */
+    char* last;     /**< Character after its last element, null if the array
+                         ends in the part.                                     */
+    json_t* array;  /**< Array with the elements parsed with the part.         */
+    long depth[2];  /**< Change of depth if it starts out of or in a string.   */
+    long start;     /**< Depth at the first character.                         */
+    bool quotes;    /**< It has an odd number of quotes.                       */
+    bool inString;  /**< The first character is in a string.                   */
+} jsonPart_t;
+
+/** Structure to parse a top-level array in parallel. */
+typedef struct jsonSplit_s {
+    char* str;            /**< The string.                         */
+    size_t len;           /**< Its length.                         */
+    unsigned int options; /**< Optional modes. See jsonOption_t.   */
+    unsigned int qty;     /**< Number of parts.                    */
+    jsonPart_t part[ JSON_MAXPARTS ];
+} jsonSplit_t;
+
+/** Divide a string with a top-level array, like a big export of records, in
+  * parts of the same length to parse them in parallel. The steps are:
+  *  1. json_scanPart() for each part, in parallel.
+  *  2. json_findElements() once, when all of them are done.
+  *  3. json_parsePart() for each part, in parallel, each one with its pool.
+  *  4. json_joinParts() once, when all of them are done.
+  * The parts do not need to start at an element: each one is scanned without
+  * knowing whether it starts in a string, the quotes and brackets are counted
+  * for both cases, and then the state of every part is fixed in order.
+  * @param split The structure to handle the parse.
+  * @param str String pointer with a JSON array. It will be modified.
+  * @param len Length of the string without the null character.
+  * @param qty Number of parts. At most JSON_MAXPARTS.
+  * @param options Combination of codes of jsonOption_t.
+  * @return The number of parts or zero if the string does not start with an array. */
+unsigned int json_splitArray( jsonSplit_t* split, char* str, size_t len, unsigned int qty, unsigned int options );
+
+/** Count the quotes and the brackets of a part. It only reads the string.
+  * @param split The structure to handle the parse.
+  * @param i The index of the part. */
+void json_scanPart( jsonSplit_t* split, unsigned int i );
+
+/** Get the state of each part from the counts of the ones before it and find
+  * the first element of the array that starts in it. An element belongs to the
+  * part where the comma before it is.
+  * @param split The structure to handle the parse.
+  * @retval true if success.
+  * @retval false if the quotes or the brackets are not balanced. */
+bool json_findElements( jsonSplit_t* split );
+
+/** Parse the elements of the array that belong to a part.
+  * @param split The structure to handle the parse.
+  * @param i The index of the part.
+  * @param pool Custom json pool pointer. Its init function is called once and
+  *             it must not be used by any other part.
+  * @return true if success. */
+bool json_parsePart( jsonSplit_t* split, unsigned int i, jsonPool_t* pool );
+
+/** Link the elements of all parts in one array.
+  * @param split The structure to handle the parse.
+  * @retval The handler of the array if success. It is allocated from the pool of
+  *         the first part and its children from the pools of each part.
+  * @retval Null pointer if any part failed. */
+json_t const* json_joinParts( jsonSplit_t* split );
+
+#ifndef JSON_MAXPATH
+/** Maximum number of names of the path of a jsonPredicate_t. */
+#define JSON_MAXPATH 4
+#endif
+
+/** Kinds of conditions of a jsonPredicate_t. */
+typedef enum {
+    JSON_EQUAL,  /**< The value is a text equal to the text of the predicate. */
+    JSON_PREFIX, /**< The value is a text that starts with it.                */
+    JSON_RANGE   /**< The value is a number from min to max, both included.   */
+} jsonCondition_t;
+
+/** Condition on a property of a record that is checked in its raw bytes.
+  * It is built with json_initTextPredicate() or json_initRangePredicate(). */
+typedef struct jsonPredicate_s {
+    jsonCondition_t condition;         /**< Kind of condition.                  */
+    char const* text;                  /**< Text of JSON_EQUAL and JSON_PREFIX. */
+    size_t textlen;                    /**< Its length.                         */
+    double min;                        /**< First value of JSON_RANGE.          */
+    double max;                        /**< Last value of JSON_RANGE.           */
+    unsigned int depth;                /**< Number of names of the path.        */
+    char const* name[ JSON_MAXPATH ];  /**< Names of the path, not terminated.  */
+    size_t len[ JSON_MAXPATH ];        /**< Lengths of the names.               */
+} jsonPredicate_t;
+
+/** Build a condition on a text property of records.
+  * @param pred The predicate to build.
+  * @param path Names from the root object separated by '.', like "meta.level".
+  *             It must outlive the predicate.
+  * @param condition JSON_EQUAL or JSON_PREFIX.
+  * @param text The text to compare, with its characters decoded. It must
+  *             outlive the predicate.
+  * @retval true if success.
+  * @retval false if the path has an empty name or more than JSON_MAXPATH. */
+bool json_initTextPredicate( jsonPredicate_t* pred, char const* path, jsonCondition_t condition, char const* text );
+
+/** Build a condition on a number property of records.
+  * @param pred The predicate to build.
+  * @param path Names from the root object separated by '.'. It must outlive
+  *             the predicate.
+  * @param min The first value of the range.
+  * @param max The last value of the range.
+  * @retval true if success.
+  * @retval false if the path has an empty name or more than JSON_MAXPATH. */
+bool json_initRangePredicate( jsonPredicate_t* pred, char const* path, double min, double max );
+
+/** Check conditions on properties of a record, like a line of NDJSON, before
+  * parsing it. The names of the path are searched in the raw bytes, eight
+  * characters at a time, and each match is verified to be a name of the object
+  * of the path and not a part of a string or of a nested value. Only the bytes
+  * up to the properties are scanned and the record is not modified, so a
+  * matching record can be parsed after it. It does not validate the record.
+  * The first property with a name counts, the names must be written without
+  * escape sequences in the records and the numbers must be shorter than 64
+  * characters.
+  * @param str Pointer to the first character of the record. It does not need
+  *            to be null-terminated.
+  * @param len Length of the record.
+  * @param preds Array of predicates built with json_initTextPredicate() or
+  *              json_initRangePredicate().
+  * @param qty Number of predicates.
+  * @return true if the record is an object and all conditions are true. */
+bool json_matchRecord( char const* str, size_t len, jsonPredicate_t const preds[], unsigned int qty );
+
 /** @ } */
 
 #ifdef __cplusplus
@@ -0,0 +1,277 @@
+
+/*
+
+<https://github.com/rafagafe/tiny-json>
+
+  Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+  SPDX-License-Identifier: MIT
+  Copyright (c) 2016-2018 Rafa Garcia <rafagarcia77@gmail.com>.
+
+  Permission is hereby  granted, free of charge, to any  person obtaining a copy
+  of this software and associated  documentation files (the "Software"), to deal
+  in the Software  without restriction, including without  limitation the rights
+  to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+  copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+  IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+  FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+  AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+  LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#ifndef _TINY_JSON_HPP_
+#define _TINY_JSON_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include "tiny-json.h"
+
+/** @defgroup tinyJsonCpp Header-only C++17 layer over tiny-json.
+  * Every class is a thin value wrapper of a pointer of the C API,
+  * so it can be passed by value and compiles down to the same calls.
+  * @{ */
+
+namespace tinyjson {
+
+/** Get the hash of a property name at compile time.
+  * It is the same 32-bit FNV-1a hash of json_hashKey(). */
+constexpr std::uint32_t hash( char const* str, std::size_t len ) {
+    std::uint32_t h = 2166136261u;
+    for( std::size_t i = 0; i < len; ++i ) {
+        h ^= static_cast<unsigned char>( str[i] );
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/** Property name with its length and hash computed at compile time. */
+struct key {
+    char const* str;
+    std::size_t len;
+    std::uint32_t hash;
+    constexpr key( char const* s, std::size_t l ): str{ s }, len{ l }, hash{ tinyjson::hash( s, l ) } {}
+};
+
+/** Canonical name of a table of interned names. See names. */
+struct ikey {
+    char const* ptr;
+};
+
+namespace literals {
+    /** Build a key from a string literal: "timestamp"_k */
+    constexpr key operator""_k( char const* str, std::size_t len ) {
+        return key{ str, len };
+    }
+}
+
+class value;
+
+/** Range of the values of an array packed with JSON_PACK_NUMBERS. */
+template<class T>
+struct packed {
+    T const* first;
+    T const* last;
+    T const* begin() const { return first; }
+    T const* end() const { return last; }
+    std::size_t size() const { return static_cast<std::size_t>( last - first ); }
+    T operator[]( std::size_t i ) const { return first[i]; }
+};
+
+/** Forward iterator over the children of a JSON object or array. */
+class iterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = value;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = value;
+
+    constexpr iterator( json_t const* json = nullptr ): _json{ json } {}
+    value operator*() const;
+    iterator& operator++() { _json = json_getSibling( _json ); return *this; }
+    iterator operator++( int ) { iterator tmp = *this; ++*this; return tmp; }
+    bool operator==( iterator other ) const { return _json == other._json; }
+    bool operator!=( iterator other ) const { return _json != other._json; }
+
+private:
+    json_t const* _json;
+};
+
+/** Handler of a json property. It can be null if a lookup failed,
+  * and every lookup on a null handler returns a null handler. */
+class value {
+public:
+    constexpr value( json_t const* json = nullptr ): _json{ json } {}
+
+    json_t const* get() const { return _json; }
+    explicit operator bool() const { return _json != nullptr; }
+    jsonType_t type() const { return json_getType( _json ); }
+    bool is( jsonType_t t ) const { return _json && json_getType( _json ) == t; }
+    char const* name() const { return json_getName( _json ); }
+
+    /** Children of an object or array. Empty for other types. */
+    iterator begin() const { return iterator{ isContainer()? json_getChild( _json ): nullptr }; }
+    iterator end() const { return iterator{}; }
+
+    /** Search a property by its name. */
+    value operator[]( char const* property ) const {
+        return is( JSON_OBJ )? value{ json_getProperty( _json, property ) }: value{};
+    }
+
+    /** Search a property by its name. Its length is known so it is not
+      * measured again, and the objects with JSON_SORT_KEYS use their index. */
+    value operator[]( key k ) const {
+        return is( JSON_OBJ )? value{ json_getPropertyLen( _json, k.str, k.len ) }: value{};
+    }
+
+    /** Search a property by its canonical name. The json must have been
+      * parsed with the same table of interned names. */
+    value operator[]( ikey k ) const {
+        return is( JSON_OBJ ) && k.ptr? value{ json_getInternedProperty( _json, k.ptr ) }: value{};
+    }
+
+    /** Get the value as a C++ type if the json type is compatible.
+      * Supported types: bool, integral types, floating point types,
+      * char const* and std::string_view. The integers that do not fit
+      * in the integral type are not compatible. */
+    template<class T>
+    std::optional<T> get() const {
+        if ( !_json ) return std::nullopt;
+        jsonType_t const t = json_getType( _json );
+        if constexpr ( std::is_same_v<T, bool> ) {
+            if ( t != JSON_BOOLEAN ) return std::nullopt;
+            return json_getBoolean( _json );
+        }
+        else if constexpr ( std::is_integral_v<T> ) {
+            if ( t != JSON_INTEGER ) return std::nullopt;
+            std::int64_t const i = json_getInteger( _json );
+            if constexpr ( std::is_signed_v<T> ) {
+                if ( i < std::numeric_limits<T>::min() || i > std::numeric_limits<T>::max() ) return std::nullopt;
+            }
+            else if ( i < 0 || static_cast<std::uint64_t>( i ) > std::numeric_limits<T>::max() ) return std::nullopt;
+            return static_cast<T>( i );
+        }
+        else if constexpr ( std::is_floating_point_v<T> ) {
+            if ( t == JSON_INTEGER ) return static_cast<T>( json_getInteger( _json ) );
+            if ( t != JSON_REAL ) return std::nullopt;
+            return static_cast<T>( json_getReal( _json ) );
+        }
+        else if constexpr ( std::is_same_v<T, char const*> || std::is_same_v<T, std::string_view> ) {
+            if ( t == JSON_OBJ || t == JSON_ARRAY ) return std::nullopt;
+            return T{ t == JSON_TEXT? json_getText( _json ): json_getValue( _json ) };
+        }
+        else {
+            static_assert( sizeof( T ) == 0, "Unsupported type." );
+        }
+    }
+
+    /** Get the values of an array packed with JSON_PACK_NUMBERS.
+      * T must be std::int64_t or double. The range is empty if the
+      * array is not packed or its values are of the other type. */
+    template<class T>
+    packed<T> values() const {
+        static_assert( std::is_same_v<T, std::int64_t> || std::is_same_v<T, double>, "Unsupported type." );
+        jsonType_t const expected = std::is_same_v<T, double>? JSON_REAL: JSON_INTEGER;
+        if ( !_json || json_getArrayType( _json ) != expected ) return packed<T>{ nullptr, nullptr };
+        T const* const data = static_cast<T const*>( json_getArrayData( _json ) );
+        return packed<T>{ data, data + json_getArrayLength( _json ) };
+    }
+
+    /** Get the value as a C++ type or a default value. */
+    template<class T>
+    T get_or( T def ) const {
+        std::optional<T> const val = get<T>();
+        return val? *val: def;
+    }
+
+private:
+    bool isContainer() const {
+        return _json && ( json_getType( _json ) == JSON_OBJ || json_getType( _json ) == JSON_ARRAY );
+    }
+
+    json_t const* _json;
+};
+
+inline value iterator::operator*() const { return value{ _json }; }
+
+/** Table of interned property names with static storage.
+  * @tparam Entries Number of entries. At least one is always left free.
+  * @tparam Size Number of bytes to store the names. */
+template<std::size_t Entries, std::size_t Size = Entries * 16>
+class names {
+public:
+    names() { json_initKeys( &_keys, _mem, Entries, _buf, Size ); }
+    names( names const& ) = delete;
+    names& operator=( names const& ) = delete;
+
+    /** Get the canonical name of a key. Its hash is known at compile time.
+      * The handler is null if the name has not been interned. */
+    ikey operator[]( key k ) const { return ikey{ json_findKey( &_keys, k.str, k.hash ) }; }
+
+    /** Add a name to the table. The handler is null if the table is full. */
+    ikey intern( char const* name ) { return ikey{ json_internKey( &_keys, name ) }; }
+
+    jsonKeys_t* get() { return &_keys; }
+
+private:
+    jsonKey_t _mem[Entries];
+    char _buf[Size];
+    jsonKeys_t _keys;
+};
+
+/** Parser with static storage for a number of json properties.
+  * @tparam N Maximum number of json properties of a document. */
+template<std::size_t N>
+class document: jsonPool_t {
+public:
+    document(): jsonPool_t{ &init_fn, &alloc_fn } {}
+    document( document const& ) = delete;
+    document& operator=( document const& ) = delete;
+
+    /** Parse a string. It will be modified and must outlive the document. */
+    value parse( char* str ) {
+        return _root = value{ json_createWithPool( str, this ) };
+    }
+
+    /** Parse a string and intern the names of its properties. */
+    template<std::size_t E, std::size_t S>
+    value parse( char* str, names<E, S>& table ) {
+        return _root = value{ json_createWithKeys( str, this, table.get() ) };
+    }
+
+    value root() const { return _root; }
+
+private:
+    static json_t* alloc_fn( jsonPool_t* pool ) {
+        document* const doc = static_cast<document*>( pool );
+        return doc->_next < N? &doc->_mem[ doc->_next++ ]: nullptr;
+    }
+
+    static json_t* init_fn( jsonPool_t* pool ) {
+        static_cast<document*>( pool )->_next = 0;
+        return alloc_fn( pool );
+    }
+
+    json_t _mem[N];
+    std::size_t _next{};
+    value _root{};
+};
+
+} // namespace tinyjson
+
+/** @ } */
+
+#endif /* _TINY_JSON_HPP_ */